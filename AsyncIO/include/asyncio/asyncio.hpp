@@ -1,9 +1,16 @@
 #pragma once
 
 #include "callstack.hpp"
+#include "cancellation.hpp"
+#include "channel.hpp"
+#include "connection_pool.hpp"
+#include "context.hpp"
 #include "event_loop.hpp"
 #include "gather.hpp"
+#include "generator.hpp"
 #include "handle.hpp"
+#include "locks.hpp"
+#include "metrics.hpp"
 #include "open_connection.hpp"
 #include "result.hpp"
 #include "runner.hpp"
@@ -12,4 +19,10 @@
 #include "start_server.hpp"
 #include "stream.hpp"
 #include "task.hpp"
+#include "task_accounting.hpp"
+#include "task_group.hpp"
+#include "trace.hpp"
 #include "wait_for.hpp"
+#include "watchdog.hpp"
+#include "when_any.hpp"
+#include "yield.hpp"
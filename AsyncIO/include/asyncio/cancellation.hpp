@@ -0,0 +1,54 @@
+/**
+ *  协作式取消: 取消令牌 CancellationToken.
+ *  - 协程 (CoroHandle) 创建时继承当前正在运行的协程的令牌
+ *  - 挂起中的可等待对象 (Sleep, IO 等待) 在令牌上登记回调, 令牌被取消时立即被唤醒并抛出 CancelledError
+ *  - 子令牌登记在父令牌上, 取消父令牌会级联取消整棵子树
+ */
+
+#pragma once
+
+#include <asyncio/detail/intrusive_list.hpp>
+#include <asyncio/detail/noncopyable.hpp>
+
+namespace asyncio {
+
+class CancellationToken : NonCopyable {
+public:
+    // 登记在令牌上的取消回调 (侵入式节点, 登记/注销不分配内存)
+    struct Callback : detail::IntrusiveListNode {
+        virtual ~Callback() = default;
+
+        // 令牌被取消时调用 (调用前已从令牌上注销)
+        virtual void OnCancel() = 0;
+    };
+
+    // parent: 父令牌, 父令牌被取消时本令牌随之取消
+    explicit CancellationToken(CancellationToken* parent = nullptr);
+
+public:
+    // 是否已被取消
+    bool IsCancelled() const { return cancelled_; }
+
+    // 取消令牌: 按登记顺序唤醒所有回调, O(回调数)
+    void Cancel();
+
+    // 登记回调 (令牌已被取消时立即调用)
+    void Register(Callback& callback);
+
+private:
+    // 父令牌被取消时取消自己
+    struct ParentLink : Callback {
+        explicit ParentLink(CancellationToken& token) : token_(token) {}
+
+        void OnCancel() override final { token_.Cancel(); }
+
+        CancellationToken& token_;
+    };
+
+private:
+    bool cancelled_{false};                      // 是否已被取消
+    detail::IntrusiveList<Callback> callbacks_;  // 登记的回调
+    ParentLink parent_link_{*this};              // 登记在父令牌上的节点
+};
+
+}  // namespace asyncio
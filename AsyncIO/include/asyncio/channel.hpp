@@ -0,0 +1,498 @@
+/**
+ *  协程间传递数据的通道.
+ *  - Channel<T>: 多生产者多消费者, 有界 (满时 Send 挂起) 或无界
+ *  - SpscChannel<T>: 单生产者单消费者, 环形缓冲区 (容量向上取整为 2 的幂), 吞吐量更高
+ *  挂起的 Send/Recv 经事件循环 (CallSoon) 恢复; 有接收者等待时 Send 把值直接交给接收者.
+ *  Close() 之后: Send 抛出 ChannelClosedError, Recv 取完剩余数据后返回 std::nullopt.
+ *  RecvMany(span) 一次唤醒取走尽可能多的数据, 适合流水线的批处理.
+ */
+
+#pragma once
+
+// std
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+// asyncio
+#include <asyncio/detail/intrusive_list.hpp>
+#include <asyncio/detail/noncopyable.hpp>
+#include <asyncio/exception.hpp>
+#include <asyncio/locks.hpp>
+
+namespace asyncio {
+
+namespace detail {
+
+// 挂起的接收者: 发送方把值直接交给它
+template <typename T>
+struct ChannelReceiver : SyncWaiter {
+    virtual void Deliver(T&& value) = 0;
+};
+
+}  // namespace detail
+
+template <typename T>
+class Channel : NonCopyable {
+    using Receiver = detail::ChannelReceiver<T>;
+
+    struct SendAwaiter : detail::SyncWaiter {
+        SendAwaiter(Channel& channel, T&& value) : channel_(channel), value_(std::move(value)) {}
+
+        bool await_ready() {
+            delivered_ = channel_.TrySend(value_);
+            return Ready(delivered_ || channel_.closed_);
+        }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> caller) {
+            if (yield_) {
+                Reschedule(caller.promise());
+                return true;
+            }
+            if (!Suspend(caller.promise())) {
+                return false;
+            }
+            channel_.senders_.PushBack(*this);
+            return true;
+        }
+
+        void await_resume() {
+            Resume();
+            if (!delivered_) {
+                throw ChannelClosedError{};
+            }
+        }
+
+        Channel& channel_;
+        T value_;
+        bool delivered_{false};  // 值是否已进入通道
+    };
+
+    struct RecvAwaiter : Receiver {
+        explicit RecvAwaiter(Channel& channel) : channel_(channel) {}
+
+        // 已被交付但协程被销毁: 把值放回通道头部
+        ~RecvAwaiter() {
+            if (this->OwnsPending() && value_) {
+                channel_.buffer_.push_front(std::move(*value_));
+            }
+        }
+
+        bool await_ready() {
+            value_ = channel_.TryRecv();
+            return this->Ready(value_.has_value() || channel_.closed_);
+        }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> caller) {
+            if (this->yield_) {
+                this->Reschedule(caller.promise());
+                return true;
+            }
+            if (!this->Suspend(caller.promise())) {
+                return false;
+            }
+            channel_.receivers_.PushBack(*this);
+            return true;
+        }
+
+        std::optional<T> await_resume() {
+            this->Resume();
+            return std::move(value_);
+        }
+
+        void Deliver(T&& value) override final { value_.emplace(std::move(value)); }
+
+        Channel& channel_;
+        std::optional<T> value_;
+    };
+
+    struct RecvManyAwaiter : Receiver {
+        RecvManyAwaiter(Channel& channel, std::span<T> out) : channel_(channel), out_(out) {}
+
+        // 已取到数据但协程被销毁: 按原顺序放回通道头部
+        ~RecvManyAwaiter() {
+            if (this->OwnsPending()) {
+                while (count_ > 0) {
+                    channel_.buffer_.push_front(std::move(out_[--count_]));
+                }
+            }
+        }
+
+        bool await_ready() {
+            count_ = channel_.TryRecvMany(out_);
+            return this->Ready(count_ > 0 || out_.empty() || channel_.closed_);
+        }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> caller) {
+            if (this->yield_) {
+                this->Reschedule(caller.promise());
+                return true;
+            }
+            if (!this->Suspend(caller.promise())) {
+                return false;
+            }
+            channel_.receivers_.PushBack(*this);
+            return true;
+        }
+
+        // 被唤醒后继续取走唤醒前已进入缓冲区的数据
+        size_t await_resume() {
+            this->Resume();
+            if (count_ > 0) {
+                count_ += channel_.TryRecvMany(out_.subspan(count_));
+            }
+            return count_;
+        }
+
+        void Deliver(T&& value) override final { out_[count_++] = std::move(value); }
+
+        Channel& channel_;
+        std::span<T> out_;
+        size_t count_{0};  // 已取到的数量
+    };
+
+public:
+    static constexpr size_t unbounded = std::numeric_limits<size_t>::max();
+
+    // capacity: 缓冲区容量 (>= 1), 默认无界
+    explicit Channel(size_t capacity = unbounded) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+public:
+    // 发送: 通道满时挂起; 通道已关闭时抛出 ChannelClosedError
+    [[nodiscard]]
+    auto Send(T value) {
+        return SendAwaiter{*this, std::move(value)};
+    }
+
+    // 接收: 通道空时挂起; 通道已关闭且数据取完时返回 std::nullopt
+    [[nodiscard]]
+    auto Recv() {
+        return RecvAwaiter{*this};
+    }
+
+    // 批量接收: 至少取到 1 个时返回取到的数量; 通道已关闭且数据取完时返回 0
+    [[nodiscard]]
+    auto RecvMany(std::span<T> out) {
+        return RecvManyAwaiter{*this, out};
+    }
+
+    // 尝试发送 (不挂起), 成功时移走 value
+    bool TrySend(T& value) {
+        if (closed_) {
+            return false;
+        }
+        if (auto receiver = receivers_.PopFront()) {  // 直接交给等待的接收者
+            receiver->Deliver(std::move(value));
+            receiver->Wakeup();
+            return true;
+        }
+        if (buffer_.size() < capacity_) {
+            buffer_.push_back(std::move(value));
+            return true;
+        }
+        return false;
+    }
+
+    // 尝试接收 (不挂起)
+    std::optional<T> TryRecv() {
+        if (buffer_.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> value{std::move(buffer_.front())};
+        buffer_.pop_front();
+        AdmitSender();
+        return value;
+    }
+
+    // 尝试批量接收 (不挂起), 返回取到的数量
+    size_t TryRecvMany(std::span<T> out) {
+        size_t count = 0;
+        while (count < out.size() && !buffer_.empty()) {
+            out[count++] = std::move(buffer_.front());
+            buffer_.pop_front();
+            AdmitSender();
+        }
+        return count;
+    }
+
+    // 关闭通道: 唤醒所有等待者 (发送者抛出 ChannelClosedError, 接收者取完剩余数据后返回空)
+    void Close() {
+        closed_ = true;
+        while (auto sender = senders_.PopFront()) {
+            sender->Wakeup();
+        }
+        while (auto receiver = receivers_.PopFront()) {
+            receiver->Wakeup();
+        }
+    }
+
+    bool IsClosed() const { return closed_; }
+
+    // 缓冲区中的数据量
+    size_t Size() const { return buffer_.size(); }
+
+    size_t Capacity() const { return capacity_; }
+
+private:
+    // 缓冲区腾出空位: 让队首挂起的发送者的值进入缓冲区
+    void AdmitSender() {
+        if (auto sender = senders_.PopFront()) {
+            buffer_.push_back(std::move(sender->value_));
+            sender->delivered_ = true;
+            sender->Wakeup();
+        }
+    }
+
+private:
+    size_t capacity_;                             // 缓冲区容量
+    bool closed_{false};                          // 是否已关闭
+    std::deque<T> buffer_;                        // 缓冲区
+    detail::IntrusiveList<SendAwaiter> senders_;  // 挂起的发送者 (通道满)
+    detail::IntrusiveList<Receiver> receivers_;   // 挂起的接收者 (通道空)
+};
+
+// 单生产者单消费者通道: 至多一个挂起的发送者和一个挂起的接收者, 无需等待队列
+// NOTE: T 需要可默认构造 (环形缓冲区预先分配)
+template <std::default_initializable T>
+class SpscChannel : NonCopyable {
+    using Receiver = detail::ChannelReceiver<T>;
+
+    struct SendAwaiter : detail::SyncWaiter {
+        SendAwaiter(SpscChannel& channel, T&& value) : channel_(channel), value_(std::move(value)) {}
+
+        ~SendAwaiter() {
+            if (channel_.sender_ == this) {
+                channel_.sender_ = nullptr;
+            }
+        }
+
+        bool await_ready() {
+            delivered_ = channel_.TrySend(value_);
+            return Ready(delivered_ || channel_.closed_);
+        }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> caller) {
+            if (yield_) {
+                Reschedule(caller.promise());
+                return true;
+            }
+            if (!Suspend(caller.promise())) {
+                return false;
+            }
+            assert(!channel_.sender_ && "SpscChannel: only one producer");
+            channel_.sender_ = this;
+            return true;
+        }
+
+        void await_resume() {
+            Resume();
+            if (!delivered_) {
+                throw ChannelClosedError{};
+            }
+        }
+
+        void OnCancel() override final {
+            channel_.sender_ = nullptr;
+            SyncWaiter::OnCancel();
+        }
+
+        SpscChannel& channel_;
+        T value_;
+        bool delivered_{false};
+    };
+
+    struct RecvAwaiter : Receiver {
+        explicit RecvAwaiter(SpscChannel& channel) : channel_(channel) {}
+
+        ~RecvAwaiter() {
+            if (channel_.receiver_ == this) {
+                channel_.receiver_ = nullptr;
+            }
+        }
+
+        bool await_ready() {
+            value_ = channel_.TryRecv();
+            return this->Ready(value_.has_value() || channel_.closed_);
+        }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> caller) {
+            if (this->yield_) {
+                this->Reschedule(caller.promise());
+                return true;
+            }
+            if (!this->Suspend(caller.promise())) {
+                return false;
+            }
+            assert(!channel_.receiver_ && "SpscChannel: only one consumer");
+            channel_.receiver_ = this;
+            return true;
+        }
+
+        std::optional<T> await_resume() {
+            this->Resume();
+            return std::move(value_);
+        }
+
+        void Deliver(T&& value) override final { value_.emplace(std::move(value)); }
+
+        void OnCancel() override final {
+            channel_.receiver_ = nullptr;
+            Receiver::OnCancel();
+        }
+
+        SpscChannel& channel_;
+        std::optional<T> value_;
+    };
+
+    struct RecvManyAwaiter : Receiver {
+        RecvManyAwaiter(SpscChannel& channel, std::span<T> out) : channel_(channel), out_(out) {}
+
+        ~RecvManyAwaiter() {
+            if (channel_.receiver_ == this) {
+                channel_.receiver_ = nullptr;
+            }
+        }
+
+        bool await_ready() {
+            count_ = channel_.TryRecvMany(out_);
+            return this->Ready(count_ > 0 || out_.empty() || channel_.closed_);
+        }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> caller) {
+            if (this->yield_) {
+                this->Reschedule(caller.promise());
+                return true;
+            }
+            if (!this->Suspend(caller.promise())) {
+                return false;
+            }
+            assert(!channel_.receiver_ && "SpscChannel: only one consumer");
+            channel_.receiver_ = this;
+            return true;
+        }
+
+        size_t await_resume() {
+            this->Resume();
+            if (count_ > 0) {
+                count_ += channel_.TryRecvMany(out_.subspan(count_));
+            }
+            return count_;
+        }
+
+        void Deliver(T&& value) override final { out_[count_++] = std::move(value); }
+
+        void OnCancel() override final {
+            channel_.receiver_ = nullptr;
+            Receiver::OnCancel();
+        }
+
+        SpscChannel& channel_;
+        std::span<T> out_;
+        size_t count_{0};
+    };
+
+public:
+    // capacity 向上取整为 2 的幂 (下标用位与取模)
+    explicit SpscChannel(size_t capacity)
+        : ring_(std::bit_ceil(std::max<size_t>(capacity, 1))), mask_(ring_.size() - 1) {}
+
+public:
+    [[nodiscard]]
+    auto Send(T value) {
+        return SendAwaiter{*this, std::move(value)};
+    }
+
+    [[nodiscard]]
+    auto Recv() {
+        return RecvAwaiter{*this};
+    }
+
+    [[nodiscard]]
+    auto RecvMany(std::span<T> out) {
+        return RecvManyAwaiter{*this, out};
+    }
+
+    bool TrySend(T& value) {
+        if (closed_) {
+            return false;
+        }
+        if (auto receiver = std::exchange(receiver_, nullptr)) {
+            receiver->Deliver(std::move(value));
+            receiver->Wakeup();
+            return true;
+        }
+        if (tail_ - head_ == ring_.size()) {
+            return false;
+        }
+        ring_[tail_++ & mask_] = std::move(value);
+        return true;
+    }
+
+    std::optional<T> TryRecv() {
+        if (head_ == tail_) {
+            return std::nullopt;
+        }
+        std::optional<T> value{std::move(ring_[head_++ & mask_])};
+        AdmitSender();
+        return value;
+    }
+
+    size_t TryRecvMany(std::span<T> out) {
+        size_t count = std::min(out.size(), tail_ - head_);
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = std::move(ring_[head_++ & mask_]);
+        }
+        if (count > 0) {
+            AdmitSender();
+        }
+        return count;
+    }
+
+    void Close() {
+        closed_ = true;
+        if (auto sender = std::exchange(sender_, nullptr)) {
+            sender->Wakeup();
+        }
+        if (auto receiver = std::exchange(receiver_, nullptr)) {
+            receiver->Wakeup();
+        }
+    }
+
+    bool IsClosed() const { return closed_; }
+
+    size_t Size() const { return tail_ - head_; }
+
+    size_t Capacity() const { return ring_.size(); }
+
+private:
+    void AdmitSender() {
+        if (auto sender = std::exchange(sender_, nullptr)) {
+            ring_[tail_++ & mask_] = std::move(sender->value_);
+            sender->delivered_ = true;
+            sender->Wakeup();
+        }
+    }
+
+private:
+    std::vector<T> ring_;    // 环形缓冲区
+    size_t mask_;            // ring_.size() - 1
+    size_t head_{0};         // 读位置 (单调递增)
+    size_t tail_{0};         // 写位置 (单调递增)
+    bool closed_{false};     // 是否已关闭
+    SendAwaiter* sender_{};  // 挂起的发送者 (通道满)
+    Receiver* receiver_{};   // 挂起的接收者 (通道空)
+};
+
+}  // namespace asyncio
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+//
+#include <asyncio/detail/noncopyable.hpp>
+#include <asyncio/event_loop.hpp>
+#include <asyncio/handle.hpp>
+#include <asyncio/open_connection.hpp>
+#include <asyncio/stream.hpp>
+#include <asyncio/task.hpp>
+
+namespace asyncio {
+
+class ConnectionPool;
+
+// 连接池配置
+struct ConnectionPoolOptions {
+    size_t max_per_host{16};  // 每个 host:port 的连接上限 (借出 + 空闲 + 正在建立)
+    std::chrono::milliseconds idle_timeout{std::chrono::seconds(30)};  // 空闲连接的最长保留时间
+    ConnectOptions connect{};  // 新建连接时的连接选项 (超时等)
+};
+
+// 连接池统计信息
+struct ConnectionPoolStats {
+    uint64_t hits{};       // 复用已有连接的次数 (空闲连接或排队时直接移交)
+    uint64_t misses{};     // 新建连接的次数
+    uint64_t waits{};      // 因达到连接上限而排队的次数
+    uint64_t evictions{};  // 空闲超时被驱逐的连接数
+    uint64_t stale{};      // 健康检查失败 (对端已关闭) 被丢弃的空闲连接数
+    std::chrono::milliseconds total_wait_time{};  // 累计排队时间
+    std::chrono::milliseconds max_wait_time{};    // 单次最长排队时间
+};
+
+// 从连接池借出的网络流, 析构或 Release() 时自动归还连接池
+class PooledStream : NonCopyable {
+public:
+    PooledStream(ConnectionPool& pool, std::string key, Stream stream);
+
+    // NOTE: 移动前先注销读写事件, 避免 epoll 中仍指向旧 Stream 的事件
+    PooledStream(PooledStream&& other);
+
+    ~PooledStream() { Release(); }
+
+public:
+    Stream& operator*() { return *stream_; }
+
+    Stream* operator->() { return &*stream_; }
+
+    // 标记连接已损坏 (读写出错/协议状态未知), 归还时直接关闭而不放回空闲队列
+    void MarkBroken() { broken_ = true; }
+
+    // 提前归还连接 (之后不可再使用)
+    void Release();
+
+    // 是否仍持有连接
+    bool IsValid() const { return pool_ != nullptr; }
+
+private:
+    ConnectionPool* pool_;          // 所属连接池
+    std::string key_;               // host:port
+    std::optional<Stream> stream_;  // 借出的网络流
+    bool broken_{false};            // 是否已损坏
+};
+
+// 客户端连接池: 按 host:port 复用 keep-alive 连接
+// - 每个 host:port 的连接数有上限, 超出上限的请求按 FIFO 顺序排队
+// - 归还的连接放入空闲队列, 复用前通过可读性检查判断对端是否已关闭
+// - 空闲超时的连接由事件循环的定时器驱逐
+// NOTE: 连接池必须比所有借出的 PooledStream 以及排队中的协程活得更久
+class ConnectionPool : NonCopyable {
+    friend class PooledStream;
+
+public:
+    explicit ConnectionPool(ConnectionPoolOptions options = {}) : options_(options) {}
+
+    ~ConnectionPool();
+
+public:
+    // 借出一个到 host:port 的连接 (优先复用空闲连接, 达到上限时排队等待)
+    Task<PooledStream> Acquire(std::string_view host, uint16_t port);
+
+    // 获取统计信息
+    ConnectionPoolStats const& GetStats() const { return stats_; }
+
+    // 当前空闲连接总数
+    size_t IdleCount() const;
+
+private:
+    // 空闲连接
+    struct IdleConnection {
+        Stream stream;                    // 网络流 (已注销读写事件)
+        std::chrono::nanoseconds since;   // 放入空闲队列的时间 (EventLoop::time())
+    };
+
+    struct Waiter;
+
+    // 单个 host:port 的连接状态
+    struct HostEntry {
+        size_t total{0};                  // 借出 + 空闲 + 正在建立的连接数
+        std::deque<IdleConnection> idle;  // 空闲连接 (尾部最新, 头部最旧)
+        std::deque<Waiter*> waiters;      // 排队等待连接的协程 (FIFO)
+    };
+
+    // 排队等待连接的可等待对象, 被唤醒时要么拿到移交的连接, 要么拿到新建连接的名额
+    struct Waiter : NonCopyable {
+        Waiter(ConnectionPool& pool, HostEntry& entry) : pool_(pool), entry_(entry) {}
+
+        ~Waiter() {
+            if (!granted_) {  // 排队中被取消: 从等待队列中移除
+                std::erase(entry_.waiters, this);
+            } else if (!resumed_) {  // 已被唤醒但协程尚未恢复就被销毁: 归还移交的连接或名额
+                pool_.Regrant(entry_, std::move(stream_));
+            }
+        }
+
+        constexpr bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> caller) noexcept {
+            continuation_ = &caller.promise();
+            continuation_->SetState(Handle::SUSPEND);
+            entry_.waiters.push_back(this);
+        }
+
+        void await_resume() noexcept { resumed_ = true; }
+
+        ConnectionPool& pool_;
+        HostEntry& entry_;
+        CoroHandle* continuation_{};    // 排队的协程
+        std::optional<Stream> stream_;  // 直接移交的连接 (为空表示获得新建连接的名额)
+        bool granted_{false};           // 是否已被唤醒
+        bool resumed_{false};           // 协程是否已恢复执行
+    };
+
+    // 空闲连接驱逐定时器
+    struct EvictHandle : Handle {
+        explicit EvictHandle(ConnectionPool& pool) : pool_(pool) {}
+
+        void Run() override final { pool_.EvictIdle(); }
+
+        ConnectionPool& pool_;
+    };
+
+private:
+    // 归还连接 (由 PooledStream 调用)
+    void Release(std::string const& key, Stream&& stream, bool broken);
+
+    // 释放一个连接名额: 有排队者则把名额交给队首, 否则连接数减一
+    void ReleaseSlot(HostEntry& entry);
+
+    // 唤醒队首排队者
+    void Wakeup(HostEntry& entry, std::optional<Stream> stream);
+
+    // 被唤醒的排队者未恢复就被销毁: 连接移交给下一个排队者或放回空闲队列, 名额则释放
+    void Regrant(HostEntry& entry, std::optional<Stream> stream);
+
+    // 驱逐空闲超时的连接, 并为下一个最早到期的空闲连接重新设置定时器
+    void EvictIdle();
+
+    // 设置驱逐定时器 (已设置则忽略)
+    void ArmEvictor(std::chrono::nanoseconds delay);
+
+    // 空闲连接健康检查: 空闲连接上不应出现可读事件, 可读意味着对端已关闭或发来了意外数据
+    static bool IsHealthy(Stream const& stream);
+
+private:
+    ConnectionPoolOptions options_;
+    ConnectionPoolStats stats_;
+    std::unordered_map<std::string, HostEntry> hosts_;  // host:port -> 连接状态
+    EvictHandle evictor_{*this};                        // 驱逐定时器
+    bool evictor_armed_{false};                         // 驱逐定时器是否已设置
+};
+
+}  // namespace asyncio
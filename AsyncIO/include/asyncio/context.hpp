@@ -0,0 +1,115 @@
+/**
+ *  协程上下文变量: 沿协程创建关系传递的请求级数据 (trace id, 截止时间, 租户 ...).
+ *  - 协程 (CoroHandle) 创建时继承当前正在运行的协程的上下文 (与取消令牌相同), 只增加引用计数
+ *  - 修改时写时复制: 只影响当前协程及此后由它创建的协程, 不影响父协程和已创建的子协程
+ *  - 查找按 ContextVar 的下标 O(1) 访问, 不分配内存
+ *  - 不在协程中 (例如 Run 之前) 访问的是根上下文
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+//
+#include <asyncio/detail/noncopyable.hpp>
+
+namespace asyncio {
+
+// 上下文快照的引用 (侵入式引用计数, 事件循环单线程运行, 非原子)
+// NOTE: 空引用表示没有设置任何变量的上下文, 继承与查找都不分配内存
+class Context {
+public:
+    Context() noexcept = default;
+
+    Context(Context const& other) noexcept : node_(other.node_) {
+        if (node_) {
+            ++node_->refs;
+        }
+    }
+
+    Context& operator=(Context other) noexcept {
+        std::swap(node_, other.node_);
+        return *this;
+    }
+
+    ~Context() {
+        if (node_ && --node_->refs == 0) {
+            delete node_;
+        }
+    }
+
+public:
+    // 当前正在运行的协程的上下文
+    static Context& Current() { return *current_; }
+
+    // 切换当前上下文, 返回之前的上下文 (由 CoroHandle::Resume() 维护)
+    static Context* Switch(Context* context) { return std::exchange(current_, context); }
+
+    // 查找下标为 index 的变量 (未设置时返回 nullptr)
+    void const* Get(uint32_t index) const {
+        if (node_ && index < node_->values.size()) [[likely]] {
+            return node_->values[index].get();
+        }
+        return nullptr;
+    }
+
+    // 设置下标为 index 的变量 (value 为空表示清除), 与其他协程共享快照时先复制
+    void Set(uint32_t index, std::shared_ptr<void const> value);
+
+    // 分配一个新的变量下标 (ContextVar 构造时调用)
+    static uint32_t NewIndex() { return next_index_++; }
+
+private:
+    // 上下文快照: 按变量下标保存值, 值本身不可变, 快照之间共享
+    struct Node {
+        uint32_t refs{1};
+        std::vector<std::shared_ptr<void const>> values;
+    };
+
+    Node* node_{};
+
+    inline static uint32_t next_index_{0};
+    static Context root_;      // 根上下文
+    static Context* current_;  // 当前正在运行的协程的上下文
+};
+
+inline Context Context::root_;
+inline Context* Context::current_{&Context::root_};
+
+// 上下文变量: 通常定义为全局/静态变量, 每个变量在上下文中占一个下标 (不回收)
+template <typename T>
+class ContextVar : NonCopyable {
+public:
+    ContextVar() : index_(Context::NewIndex()) {}
+
+public:
+    // 当前协程上下文中的值 (未设置时返回 nullptr)
+    T const* Get() const { return Get(Context::Current()); }
+
+    // 指定上下文中的值 (例如另一个协程的 CoroHandle::context_)
+    T const* Get(Context const& context) const {
+        return static_cast<T const*>(context.Get(index_));
+    }
+
+    // 当前协程上下文中的值 (未设置时返回 fallback)
+    T const& ValueOr(T const& fallback) const {
+        auto value = Get();
+        return value ? *value : fallback;
+    }
+
+    // 在当前协程的上下文中设置值
+    template <typename... Args>
+    void Set(Args&&... args) {
+        Context::Current().Set(index_, std::make_shared<T const>(std::forward<Args>(args)...));
+    }
+
+    // 在当前协程的上下文中清除值
+    void Reset() { Context::Current().Set(index_, nullptr); }
+
+private:
+    uint32_t index_;  // 在上下文中的下标
+};
+
+}  // namespace asyncio
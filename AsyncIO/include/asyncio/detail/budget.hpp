@@ -0,0 +1,44 @@
+// 操作预算: 协程每次恢复执行后, 不挂起就能完成的操作 (已就绪的 IO, 通道, 同步原语) 的次数上限
+// 预算耗尽后这些操作仍然完成, 但会先让出一次事件循环 (见 Yield()), 使其他协程与 IO 有机会运行
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include <asyncio/detail/config.hpp>
+
+namespace asyncio::detail {
+
+class OperationBudget {
+public:
+    // 每次恢复执行的预算, 0 表示不限制
+    static void SetLimit(uint32_t limit) {
+        limit_ = limit == 0 ? std::numeric_limits<uint32_t>::max() : limit;
+        remaining_ = limit_;
+    }
+
+    static uint32_t Limit() {
+        return limit_ == std::numeric_limits<uint32_t>::max() ? 0 : limit_;
+    }
+
+    // 协程恢复执行时重置 (CoroHandle::Resume)
+    static void Reset() { remaining_ = limit_; }
+
+    // 消耗一次预算, 返回 false 表示已耗尽 (应当让出)
+    static bool Consume() {
+        if (remaining_ == 0) [[unlikely]] {
+            return false;
+        }
+        --remaining_;
+        return true;
+    }
+
+private:
+    inline static uint32_t limit_{ASYNCIO_OPERATION_BUDGET == 0
+                                      ? std::numeric_limits<uint32_t>::max()
+                                      : uint32_t(ASYNCIO_OPERATION_BUDGET)};
+    inline static uint32_t remaining_{limit_};
+};
+
+}  // namespace asyncio::detail
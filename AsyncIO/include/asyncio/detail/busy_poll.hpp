@@ -0,0 +1,56 @@
+// 忙轮询窗口 (EventLoop::EnableBusyPoll): 事件循环将要阻塞在 Select 之前, 先以零超时轮询多长时间
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+namespace asyncio::detail {
+
+// 自适应时按最近的到达间隔调整窗口 (与 KVM halt-polling 相同的启发式):
+// - 阻塞后不久 (不超过最大窗口) 就有事件到达: 更长的轮询本可以接住它, 窗口翻倍
+// - 阻塞超过最大窗口: 事件稀疏, 轮询只是空耗 CPU, 窗口减半 (小于 1us 时不再轮询)
+// 固定窗口时总是轮询最大窗口
+class BusyPollWindow {
+public:
+    static constexpr std::chrono::nanoseconds kMinWindow = std::chrono::microseconds(1);
+
+    void Configure(std::chrono::nanoseconds max, bool adaptive) {
+        max_ = std::max(max, std::chrono::nanoseconds(0));
+        adaptive_ = adaptive;
+        window_ = adaptive ? GrowStart() : max_;
+    }
+
+    bool Enabled() const { return max_.count() > 0; }
+
+    // 本次轮询的时长
+    std::chrono::nanoseconds Window() const { return window_; }
+
+    // 轮询窗口内没有事件, 转为阻塞
+    // waited: 从开始轮询到 Select 返回的总时长, io: 是否因 IO 事件返回 (否则为定时器超时)
+    void OnBlocked(std::chrono::nanoseconds waited, bool io) {
+        if (!adaptive_) {
+            return;
+        }
+        if (waited > max_) {
+            window_ /= 2;
+            if (window_ < kMinWindow) {
+                window_ = std::chrono::nanoseconds(0);
+            }
+        } else if (io) {
+            window_ = window_ < kMinWindow ? GrowStart() : std::min(window_ * 2, max_);
+        }
+    }
+
+private:
+    // 从不轮询恢复时的窗口
+    std::chrono::nanoseconds GrowStart() const {
+        return std::min(std::max(max_ / 8, kMinWindow), max_);
+    }
+
+    std::chrono::nanoseconds max_{0};     // 最大窗口, 0 表示关闭
+    std::chrono::nanoseconds window_{0};  // 当前窗口
+    bool adaptive_{true};
+};
+
+}  // namespace asyncio::detail
@@ -0,0 +1,57 @@
+// 时钟策略 (BasicEventLoop 的 ClockPolicy): 事件循环每次迭代读一次, 用于全部定时器计算
+// Now() 返回单调递增的纳秒数 (起点任意)
+
+#pragma once
+
+#include <time.h>
+
+#include <chrono>
+#include <cstdint>
+
+namespace asyncio {
+
+// CLOCK_MONOTONIC (与 std::chrono::steady_clock 相同, vDSO 读取约 20ns)
+struct MonotonicClock {
+    static std::chrono::nanoseconds Now() noexcept {
+        timespec ts;
+        ::clock_gettime(CLOCK_MONOTONIC, &ts);
+        return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+    }
+};
+
+// CLOCK_MONOTONIC_COARSE: 读取最快 (只读内核的节拍时间), 精度为一个时钟节拍 (通常 1~4ms)
+// NOTE: 定时器到期可能晚一个节拍, 适合超时精度要求不高而迭代非常频繁的场景
+struct CoarseMonotonicClock {
+    static std::chrono::nanoseconds Now() noexcept {
+        timespec ts;
+        ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+        return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+    }
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+// 校准过的 TSC (rdtsc): 不经过 vDSO, 首次使用时以 CLOCK_MONOTONIC 校准频率 (约 10ms)
+// NOTE: CPU 不支持恒定频率的 TSC (invariant TSC) 时退化为 CLOCK_MONOTONIC
+struct TscClock {
+    static std::chrono::nanoseconds Now() noexcept {
+        auto const& calibration = Calibration::Get();
+        if (!calibration.invariant) [[unlikely]] {
+            return MonotonicClock::Now();
+        }
+        auto ticks = static_cast<int64_t>(__builtin_ia32_rdtsc() - calibration.base_ticks);
+        return calibration.base + std::chrono::nanoseconds(
+                                      static_cast<int64_t>(static_cast<double>(ticks) * calibration.ns_per_tick));
+    }
+
+    struct Calibration {
+        bool invariant{false};
+        uint64_t base_ticks{};
+        std::chrono::nanoseconds base{};
+        double ns_per_tick{};
+
+        static Calibration const& Get() noexcept;
+    };
+};
+#endif
+
+}  // namespace asyncio
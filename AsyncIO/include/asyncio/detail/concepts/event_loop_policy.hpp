@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <concepts>
+#include <vector>
+//
+#include <asyncio/detail/selector/event.hpp>
+#include <asyncio/detail/timer_queue.hpp>
+#include <asyncio/handle.hpp>
+
+namespace asyncio {
+
+namespace concepts {
+
+// I/O 多路复用策略 (EpollSelector / PollSelector)
+template <typename S>
+concept SelectorPolicy = std::default_initializable<S> && requires(S s, Event const& event) {
+    s.RegisterEvent(event);
+    s.RemoveEvent(event);
+    { s.Select(std::chrono::nanoseconds{}) } -> std::same_as<std::vector<Event>>;
+    { s.IsStop() } -> std::convertible_to<bool>;
+};
+
+// 定时任务策略: 按到期时间排序的 <到期时间, 回调> 集合 (TimerEntry)
+template <typename T>
+concept TimerPolicy =
+    std::default_initializable<T> && requires(T t, TimerEntry entry, bool (*pred)(TimerEntry const&)) {
+        t.Push(entry);
+        { t.Top() } -> std::convertible_to<TimerEntry const&>;
+        t.Pop();
+        { t.EraseIf(pred) } -> std::convertible_to<size_t>;
+        { t.Empty() } -> std::convertible_to<bool>;
+        { t.Size() } -> std::convertible_to<size_t>;
+    };
+
+// 就绪队列策略: 先进先出的回调队列
+template <typename Q>
+concept ReadyQueuePolicy = std::default_initializable<Q> && requires(Q q, HandleInfo info) {
+    q.Push(info);
+    { q.Front() } -> std::convertible_to<HandleInfo const&>;
+    q.Pop();
+    { q.Empty() } -> std::convertible_to<bool>;
+    { q.Size() } -> std::convertible_to<size_t>;
+};
+
+// 时钟策略: 单调递增的纳秒数 (MonotonicClock / CoarseMonotonicClock / TscClock)
+template <typename C>
+concept ClockPolicy = requires {
+    { C::Now() } -> std::same_as<std::chrono::nanoseconds>;
+};
+
+}  // namespace concepts
+
+}  // namespace asyncio
@@ -0,0 +1,92 @@
+// 编译期配置
+
+#pragma once
+
+// ASYNCIO_ENABLE_FRAME_INFO: 每个协程帧是否保存创建位置 (std::source_location)
+// - 开启: DumpBacktrace / FrameName 输出协程函数名与源码位置
+// - 关闭: 协程 promise 不保存源码位置, 回溯只输出协程帧的地址
+// 默认 Debug 构建开启, Release 构建 (NDEBUG) 关闭
+// NOTE: 改变 promise 布局, 库与使用者必须以相同的配置编译
+#ifndef ASYNCIO_ENABLE_FRAME_INFO
+#ifdef NDEBUG
+#define ASYNCIO_ENABLE_FRAME_INFO 0
+#else
+#define ASYNCIO_ENABLE_FRAME_INFO 1
+#endif
+#endif
+
+// ASYNCIO_ENABLE_FRAME_ALLOCATOR: 协程是否支持以 (std::allocator_arg_t, Alloc) 开头的参数指定帧分配器
+// - 开启: 见 detail/frame_allocator.hpp, 只有这类协程的帧尾部保存分配器副本, 其余协程不受影响
+// - 关闭: 协程帧总是从全局 operator new 分配
+// 默认开启
+#ifndef ASYNCIO_ENABLE_FRAME_ALLOCATOR
+#define ASYNCIO_ENABLE_FRAME_ALLOCATOR 1
+#endif
+
+// ASYNCIO_ENABLE_LOOP_METRICS: 事件循环是否支持指标统计 (见 metrics.hpp)
+// - 开启: 由 EventLoop::EnableMetrics() 在运行期开启统计, 未开启时每次迭代只多一次分支判断
+// - 关闭: 统计代码在编译期移除, Metrics() 返回空快照
+// 默认开启
+#ifndef ASYNCIO_ENABLE_LOOP_METRICS
+#define ASYNCIO_ENABLE_LOOP_METRICS 1
+#endif
+
+// ASYNCIO_ENABLE_TRACING: 是否支持协程生命周期跟踪 (见 trace.hpp)
+// - 开启: 由 EventLoop::EnableTracing() 在运行期开启, 未开启时每个跟踪点只有一次判断
+// - 关闭: 跟踪点在编译期移除
+// 默认开启
+#ifndef ASYNCIO_ENABLE_TRACING
+#define ASYNCIO_ENABLE_TRACING 1
+#endif
+
+// ASYNCIO_ENABLE_LOOP_DEBUG: 事件循环是否支持逐个回调的检测: 慢回调检测与卡顿看门狗 (见 watchdog.hpp),
+// 任务 CPU 时间统计 (见 task_accounting.hpp)
+// - 开启: 由 EventLoop::EnableSlowCallbackCheck() / EnableWatchdog() / EnableTaskAccounting() 在运行期开启,
+//   未开启时每次迭代只多一次分支判断, 每个协程销毁时多两次判断
+// - 关闭: 调试代码在编译期移除, 开启函数无效
+// 默认开启
+#ifndef ASYNCIO_ENABLE_LOOP_DEBUG
+#define ASYNCIO_ENABLE_LOOP_DEBUG 1
+#endif
+
+// ASYNCIO_ENABLE_USDT: 是否在热路径上编译 USDT 静态探针 (见 detail/probes.hpp)
+// - 开启: 需要 <sys/sdt.h> (systemtap-sdt-dev), 探针未挂载时是 nop 指令
+// - 关闭: 探针宏为空
+// 默认关闭 (xmake f --usdt=y 开启)
+#ifndef ASYNCIO_ENABLE_USDT
+#define ASYNCIO_ENABLE_USDT 0
+#endif
+
+// ASYNCIO_OPERATION_BUDGET: 协程每次恢复执行后不挂起就能完成的操作数的默认上限 (detail/budget.hpp)
+// 超过后先让出一次事件循环, 避免一个一直有数据的连接或通道独占事件循环; 0 表示不限制
+// 运行期可由 EventLoop::SetOperationBudget() 修改
+// 默认 128
+#ifndef ASYNCIO_OPERATION_BUDGET
+#define ASYNCIO_OPERATION_BUDGET 128
+#endif
+
+#if ASYNCIO_ENABLE_USDT && !__has_include(<sys/sdt.h>)
+#error "ASYNCIO_ENABLE_USDT requires <sys/sdt.h> (install systemtap-sdt-dev)"
+#endif
+
+// 事件循环策略 (见 event_loop.hpp 的 BasicEventLoop), 全局事件循环 EventLoop 使用以下实现:
+// - ASYNCIO_SELECTOR_POLICY: EpollSelector (默认, 适合大量连接) / PollSelector (少量连接)
+// - ASYNCIO_TIMER_POLICY: HeapTimerQueue (默认, 二叉堆) / QuadHeapTimerQueue (四叉堆, 适合大量定时器)
+// - ASYNCIO_READY_QUEUE_POLICY: DequeReadyQueue (默认) / RingReadyQueue (环形缓冲区, 无分块分配)
+// - ASYNCIO_CLOCK_POLICY: MonotonicClock (默认) / CoarseMonotonicClock (节拍精度) / TscClock (x86 rdtsc)
+// NOTE: 改变 EventLoop 类型, 库与使用者必须以相同的配置编译
+#ifndef ASYNCIO_SELECTOR_POLICY
+#define ASYNCIO_SELECTOR_POLICY EpollSelector
+#endif
+
+#ifndef ASYNCIO_TIMER_POLICY
+#define ASYNCIO_TIMER_POLICY HeapTimerQueue
+#endif
+
+#ifndef ASYNCIO_READY_QUEUE_POLICY
+#define ASYNCIO_READY_QUEUE_POLICY DequeReadyQueue
+#endif
+
+#ifndef ASYNCIO_CLOCK_POLICY
+#define ASYNCIO_CLOCK_POLICY MonotonicClock
+#endif
@@ -0,0 +1,73 @@
+// 协程帧分配: 支持以 (std::allocator_arg_t, Alloc) 开头的参数列表从指定分配器分配协程帧
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+//
+#include <asyncio/detail/config.hpp>
+
+namespace asyncio::detail {
+
+#if ASYNCIO_ENABLE_FRAME_ALLOCATOR
+
+// 从 Alloc 分配协程帧的 promise 基类, 提供类作用域的 operator new/delete
+// 只有参数以 (std::allocator_arg_t, Alloc) 开头的协程使用 (由 task.hpp 中
+// std::coroutine_traits 的特化选择), 普通协程的帧仍从全局 operator new 分配, 不占额外空间
+// 帧布局: [协程帧 | 分配器副本]
+template <typename Alloc>
+struct FrameAllocator {
+    template <typename... Args>  // from free function
+    static void* operator new(std::size_t size, std::allocator_arg_t, Alloc const& alloc,
+                              Args const&...) {
+        return Allocate(size, alloc);
+    }
+
+    // 成员函数协程的第一个参数是实例
+    template <typename Obj, typename... Args>  // from member function
+    static void* operator new(std::size_t size, Obj const&, std::allocator_arg_t,
+                              Alloc const& alloc, Args const&...) {
+        return Allocate(size, alloc);
+    }
+
+    static void operator delete(void* frame, std::size_t size) noexcept {
+        auto stored = std::launder(reinterpret_cast<BlockAlloc*>(
+            static_cast<std::byte*>(frame) + AllocatorOffset(size)));
+        BlockAlloc block_alloc(std::move(*stored));  // 移出后再释放其所在的内存
+        stored->~BlockAlloc();
+        std::allocator_traits<BlockAlloc>::deallocate(block_alloc, static_cast<Block*>(frame),
+                                                      BlockCount(size));
+    }
+
+private:
+    // 分配单位: 保证协程帧按 operator new 的默认对齐分配
+    // NOTE: 例如 std::pmr::polymorphic_allocator<std::byte> 只按 1 字节对齐
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) Block {
+        std::byte data[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+    };
+
+    using BlockAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Block>;
+
+    static constexpr std::size_t AllocatorOffset(std::size_t size) {
+        return (size + alignof(BlockAlloc) - 1) & ~(alignof(BlockAlloc) - 1);
+    }
+
+    // 分配的块数
+    static constexpr std::size_t BlockCount(std::size_t size) {
+        return (AllocatorOffset(size) + sizeof(BlockAlloc) + sizeof(Block) - 1) / sizeof(Block);
+    }
+
+    static void* Allocate(std::size_t size, Alloc const& alloc) {
+        BlockAlloc block_alloc(alloc);
+        void* frame =
+            std::allocator_traits<BlockAlloc>::allocate(block_alloc, BlockCount(size));
+        ::new (static_cast<std::byte*>(frame) + AllocatorOffset(size))
+            BlockAlloc(std::move(block_alloc));
+        return frame;
+    }
+};
+
+#endif
+
+}  // namespace asyncio::detail
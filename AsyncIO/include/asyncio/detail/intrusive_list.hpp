@@ -0,0 +1,85 @@
+// 侵入式双向链表: 节点嵌入在对象 (通常是挂起中的 Awaiter) 内部, 入队/出队不分配内存
+
+#pragma once
+
+#include <asyncio/detail/noncopyable.hpp>
+
+namespace asyncio {
+
+namespace detail {
+
+// 链表节点, 析构时自动从所在链表中移除
+struct IntrusiveListNode {
+    IntrusiveListNode() = default;
+
+    // NOTE: 复制/移动得到的是未链接的新节点, 已链接节点的地址不会改变
+    IntrusiveListNode(IntrusiveListNode const&) noexcept {}
+
+    IntrusiveListNode& operator=(IntrusiveListNode const&) noexcept { return *this; }
+
+    ~IntrusiveListNode() { Unlink(); }
+
+    // 是否在某个链表中
+    bool IsLinked() const noexcept { return next_ != nullptr; }
+
+    // 从所在链表中移除 (未链接时什么也不做)
+    void Unlink() noexcept {
+        if (next_) {
+            prev_->next_ = next_;
+            next_->prev_ = prev_;
+            prev_ = next_ = nullptr;
+        }
+    }
+
+    IntrusiveListNode* prev_{};
+    IntrusiveListNode* next_{};
+};
+
+// 带哨兵的环形链表, T 必须派生自 IntrusiveListNode
+// NOTE: 链表不拥有节点, 节点的生命周期由所在对象管理
+template <typename T>
+class IntrusiveList : NonCopyable {
+public:
+    IntrusiveList() noexcept { head_.prev_ = head_.next_ = &head_; }
+
+    ~IntrusiveList() { Clear(); }
+
+public:
+    bool Empty() const noexcept { return head_.next_ == &head_; }
+
+    // 加入队尾 (节点原来在其他链表中时先移除)
+    void PushBack(T& node) noexcept {
+        IntrusiveListNode& n = node;
+        n.Unlink();
+        n.prev_ = head_.prev_;
+        n.next_ = &head_;
+        head_.prev_->next_ = &n;
+        head_.prev_ = &n;
+    }
+
+    // 队首节点 (空链表返回 nullptr)
+    T* Front() noexcept { return Empty() ? nullptr : static_cast<T*>(head_.next_); }
+
+    // 移除并返回队首节点 (空链表返回 nullptr)
+    T* PopFront() noexcept {
+        auto node = Front();
+        if (node) {
+            static_cast<IntrusiveListNode*>(node)->Unlink();
+        }
+        return node;
+    }
+
+    // 移除所有节点
+    void Clear() noexcept {
+        while (!Empty()) {
+            head_.next_->Unlink();
+        }
+    }
+
+private:
+    IntrusiveListNode head_;  // 哨兵节点
+};
+
+}  // namespace detail
+
+}  // namespace asyncio
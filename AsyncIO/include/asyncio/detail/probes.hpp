@@ -0,0 +1,31 @@
+/**
+ *  USDT (SDT) 静态探针: 在生产环境用 bpftrace / perf 观察事件循环, 不需要重新编译.
+ *  - 编译期开关 ASYNCIO_ENABLE_USDT (detail/config.hpp, 默认关闭), 开启时需要 <sys/sdt.h> (systemtap-sdt-dev)
+ *  - 探针是一条 nop 指令加 ELF note, 未挂载时只有参数的计算 (都是已在寄存器中的整数)
+ *  - 提供者为 asyncio, 例如 bpftrace: usdt:./server:asyncio:handle_run_entry
+ *
+ *  探针 (参数):
+ *  - iteration_start (ready_size, timer_count)  事件循环一次迭代开始
+ *  - select_return (events, timeout_ns)         Select 返回 (timeout_ns 为 -1 表示无限等待)
+ *  - timer_fire (handle_id)                     定时任务到期
+ *  - call_soon (handle_id)                      加入就绪队列
+ *  - handle_run_entry (handle_id, is_coroutine) 开始运行回调
+ *  - handle_run_exit (handle_id)                回调运行结束
+ *  - iteration_end (callbacks)                  迭代结束 (callbacks: 本次迭代出队的回调数)
+ *  - stream_read (fd, bytes, errno)             Stream 读一次 (bytes 为 -1 表示出错, 此时 errno 非 0)
+ *  - stream_write (fd, bytes, errno)            Stream 写一次
+ *  - server_accept (listen_fd, conn_fd, errno)  Server 接受连接 (conn_fd 为 -1 表示出错)
+ */
+
+#pragma once
+
+#include <asyncio/detail/config.hpp>
+
+#if ASYNCIO_ENABLE_USDT
+#include <sys/sdt.h>
+
+#define ASYNCIO_PROBE(name, ...) STAP_PROBEV(asyncio, name __VA_OPT__(, ) __VA_ARGS__)
+#else
+// 未开启时不生成任何代码, 参数也不会被求值
+#define ASYNCIO_PROBE(name, ...) ((void)0)
+#endif
@@ -0,0 +1,103 @@
+// 就绪队列策略 (BasicEventLoop 的 ReadyQueuePolicy)
+
+#pragma once
+
+#include <array>
+#include <queue>
+#include <utility>
+#include <vector>
+//
+#include <asyncio/handle.hpp>
+
+namespace asyncio {
+
+// std::queue (std::deque) 实现
+class DequeReadyQueue {
+public:
+    void Push(HandleInfo info) { queue_.push(info); }
+
+    HandleInfo const& Front() const { return queue_.front(); }
+
+    void Pop() { queue_.pop(); }
+
+    bool Empty() const { return queue_.empty(); }
+
+    size_t Size() const { return queue_.size(); }
+
+private:
+    std::queue<HandleInfo> queue_;
+};
+
+// 环形缓冲区实现: 容量为 2 的幂, 满时翻倍 (稳定后不再分配内存)
+class RingReadyQueue {
+public:
+    void Push(HandleInfo info) {
+        if (size_ == buffer_.size()) {
+            Grow();
+        }
+        buffer_[(head_ + size_) & (buffer_.size() - 1)] = info;
+        ++size_;
+    }
+
+    HandleInfo const& Front() const { return buffer_[head_]; }
+
+    void Pop() {
+        head_ = (head_ + 1) & (buffer_.size() - 1);
+        --size_;
+    }
+
+    bool Empty() const { return size_ == 0; }
+
+    size_t Size() const { return size_; }
+
+private:
+    void Grow() {
+        std::vector<HandleInfo> buffer(buffer_.empty() ? kInitialCapacity : buffer_.size() * 2);
+        for (size_t i = 0; i < size_; ++i) {
+            buffer[i] = buffer_[(head_ + i) & (buffer_.size() - 1)];
+        }
+        buffer_ = std::move(buffer);
+        head_ = 0;
+    }
+
+private:
+    static constexpr size_t kInitialCapacity = 64;
+    std::vector<HandleInfo> buffer_;
+    size_t head_{0};  // 队首下标
+    size_t size_{0};  // 元素个数
+};
+
+namespace detail {
+
+// 按优先级分道的就绪队列: 每个优先级一条 Queue, 入队时按句柄的优先级选择
+// NOTE: 入队时读取句柄的优先级, 已取消且可能已销毁的句柄不能入队
+template <typename Queue>
+class ReadyLanes {
+public:
+    void Push(HandleInfo info) {
+        lanes_[static_cast<size_t>(info.handle->GetPriority())].Push(info);
+        ++size_;
+    }
+
+    // 取出 lane 的队首
+    HandleInfo Pop(size_t lane) {
+        HandleInfo info = lanes_[lane].Front();
+        lanes_[lane].Pop();
+        --size_;
+        return info;
+    }
+
+    bool Empty() const { return size_ == 0; }
+
+    size_t Size() const { return size_; }
+
+    size_t Size(size_t lane) const { return lanes_[lane].Size(); }
+
+private:
+    std::array<Queue, kPriorityCount> lanes_;
+    size_t size_{0};  // 所有队列的元素个数
+};
+
+}  // namespace detail
+
+}  // namespace asyncio
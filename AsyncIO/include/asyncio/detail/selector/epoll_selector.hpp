@@ -1,8 +1,12 @@
 #pragma once
 
 #include <fmt/core.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
+#include <cerrno>
+#include <chrono>
+
 #include <asyncio/detail/selector/event.hpp>
 #include <vector>
 
@@ -38,16 +42,16 @@ struct EpollSelector {
     }
 
     /**
-     * @brief 等待事件发生 (epoll_wait)
+     * @brief 等待事件发生 (epoll_pwait2, 内核不支持时退化为 epoll_wait)
      *
-     * @param timeout 超时等待时间, 单位: 毫秒
+     * @param timeout 超时等待时间, 负数表示无限等待
      * @return std::vector<Event>
      */
-    std::vector<Event> Select(int timeout) {
+    std::vector<Event> Select(std::chrono::nanoseconds timeout) {
         // errno = 0;
         std::vector<epoll_event> events;
         events.resize(register_event_count_);
-        int num_events = epoll_wait(epfd_, events.data(), register_event_count_, timeout);
+        int num_events = Wait(events, timeout);
         std::vector<Event> result;
         for (int i = 0; i < num_events; ++i) {
             auto handle_info =
@@ -71,6 +75,35 @@ struct EpollSelector {
 
     bool IsStop() { return register_event_count_ == 1; }
 
+private:
+    int Wait(std::vector<epoll_event>& events, std::chrono::nanoseconds timeout) {
+        if (timeout.count() < 0) {
+            return epoll_wait(epfd_, events.data(), register_event_count_, -1);
+        }
+#ifdef SYS_epoll_pwait2
+        // 纳秒精度的超时 (Linux 5.11+), 可以等待不足 1ms 的定时器; 直接系统调用, 不要求 glibc 2.35
+        if (has_pwait2_) {
+            auto ts = ToTimespec(timeout);
+            int n = ::syscall(SYS_epoll_pwait2, epfd_, events.data(), register_event_count_, &ts,
+                              nullptr, 0);
+            if (n >= 0 || errno != ENOSYS) {
+                return n;
+            }
+            has_pwait2_ = false;
+        }
+#endif
+        // NOTE: 毫秒向上取整: 宁可晚醒一点, 也不要在定时器到期前醒来空转
+        auto ms = std::chrono::ceil<std::chrono::milliseconds>(timeout);
+        return epoll_wait(epfd_, events.data(), register_event_count_, static_cast<int>(ms.count()));
+    }
+
+    static timespec ToTimespec(std::chrono::nanoseconds duration) {
+        auto sec = std::chrono::duration_cast<std::chrono::seconds>(duration);
+        return timespec{.tv_sec = sec.count(), .tv_nsec = (duration - sec).count()};
+    }
+
+    inline static bool has_pwait2_{true};  // 内核是否支持 epoll_pwait2
+
 private:
     int epfd_;                     // epoll 文件描述符
     int register_event_count_{1};  // 注册事件数量
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <poll.h>
+
+#include <algorithm>
+#include <asyncio/detail/selector/event.hpp>
+#include <chrono>
+#include <vector>
+
+namespace asyncio {
+
+// poll 操作封装类: 没有 epoll 实例与 epoll_ctl 系统调用, 适合少量连接
+// NOTE: 每次 Select 需要遍历所有注册的 fd, 注销为 O(n), 连接很多时应使用 EpollSelector
+struct PollSelector {
+    // 注册事件
+    void RegisterEvent(Event const& event) {
+        fds_.push_back(pollfd{.fd = event.fd, .events = static_cast<short>(event.flags), .revents = 0});
+        // 存储事件发生时要执行的任务协程句柄
+        infos_.push_back(const_cast<HandleInfo*>(&event.handle_info));
+    }
+
+    // 移除事件
+    void RemoveEvent(Event const& event) {
+        auto iter = std::ranges::find(fds_, event.fd, &pollfd::fd);
+        if (iter == fds_.end()) {
+            return;
+        }
+        size_t i = iter - fds_.begin();
+        fds_[i] = fds_.back();  // 与末尾交换后删除
+        infos_[i] = infos_.back();
+        fds_.pop_back();
+        infos_.pop_back();
+    }
+
+    /**
+     * @brief 等待事件发生 (ppoll, 纳秒精度的超时)
+     *
+     * @param timeout 超时等待时间, 负数表示无限等待
+     * @return std::vector<Event>
+     */
+    std::vector<Event> Select(std::chrono::nanoseconds timeout) {
+        std::vector<Event> result;
+        timespec ts{};
+        if (timeout.count() >= 0) {
+            auto sec = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+            ts = {.tv_sec = sec.count(), .tv_nsec = (timeout - sec).count()};
+        }
+        int num_events = ::ppoll(fds_.data(), fds_.size(), timeout.count() >= 0 ? &ts : nullptr, nullptr);
+        for (size_t i = 0; i < fds_.size() && num_events > 0; ++i) {
+            if (fds_[i].revents == 0) {
+                continue;
+            }
+            --num_events;
+            auto handle_info = infos_[i];
+            if (handle_info->handle != nullptr &&
+                handle_info->handle != (Handle*)&handle_info->handle) {
+                result.push_back(Event{.handle_info = *handle_info});
+            } else {
+                // NOTE: 与 EpollSelector 相同: 有事件发生, 但没有相应回调需要处理
+                handle_info->handle = (Handle*)&handle_info->handle;
+            }
+        }
+        return result;
+    }
+
+    bool IsStop() { return fds_.empty(); }
+
+private:
+    std::vector<pollfd> fds_;        // 注册的 fd 与关注的事件
+    std::vector<HandleInfo*> infos_;  // 与 fds_ 一一对应的句柄信息
+};
+
+}  // namespace asyncio
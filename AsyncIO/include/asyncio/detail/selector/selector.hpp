@@ -1,9 +1,12 @@
 #pragma once
 
+#include <asyncio/detail/config.hpp>
 #include <asyncio/detail/selector/epoll_selector.hpp>
+#include <asyncio/detail/selector/poll_selector.hpp>
 
 namespace asyncio {
 
-using Selector = EpollSelector;
+// 全局事件循环使用的选择器 (ASYNCIO_SELECTOR_POLICY)
+using Selector = ASYNCIO_SELECTOR_POLICY;
 
 }
@@ -0,0 +1,129 @@
+// 定时任务策略 (BasicEventLoop 的 TimerPolicy)
+// 已取消的定时任务由事件循环按 ID 惰性删除, 这里只负责按到期时间排序
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <utility>
+#include <vector>
+//
+#include <asyncio/handle.hpp>
+
+namespace asyncio {
+
+using TimerEntry = std::pair<std::chrono::nanoseconds, HandleInfo>;  // <过期时间, 回调信息>
+
+// 二叉最小堆 (std::ranges 堆算法)
+class HeapTimerQueue {
+public:
+    void Push(TimerEntry timer) {
+        heap_.push_back(timer);
+        std::ranges::push_heap(heap_, std::ranges::greater{}, &TimerEntry::first);
+    }
+
+    // 最早到期的定时任务
+    TimerEntry const& Top() const { return heap_.front(); }
+
+    void Pop() {
+        std::ranges::pop_heap(heap_, std::ranges::greater{}, &TimerEntry::first);
+        heap_.pop_back();
+    }
+
+    // 移除满足条件的定时任务并重建堆, 返回移除的数量
+    template <typename Pred>
+    size_t EraseIf(Pred pred) {
+        auto removed = std::erase_if(heap_, pred);
+        if (removed > 0) {
+            std::ranges::make_heap(heap_, std::ranges::greater{}, &TimerEntry::first);
+        }
+        return removed;
+    }
+
+    bool Empty() const { return heap_.empty(); }
+
+    size_t Size() const { return heap_.size(); }
+
+private:
+    std::vector<TimerEntry> heap_;
+};
+
+// 四叉最小堆: 树高减半, 下沉时一次比较相邻的 4 个子节点 (同一缓存行), 适合大量定时器
+class QuadHeapTimerQueue {
+public:
+    void Push(TimerEntry timer) {
+        heap_.push_back(timer);
+        SiftUp(heap_.size() - 1);
+    }
+
+    // 最早到期的定时任务
+    TimerEntry const& Top() const { return heap_.front(); }
+
+    void Pop() {
+        heap_.front() = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty()) {
+            SiftDown(0);
+        }
+    }
+
+    // 移除满足条件的定时任务并重建堆, 返回移除的数量
+    template <typename Pred>
+    size_t EraseIf(Pred pred) {
+        auto removed = std::erase_if(heap_, pred);
+        if (removed > 0 && heap_.size() > 1) {
+            for (size_t i = (heap_.size() - 2) / kArity + 1; i-- > 0;) {
+                SiftDown(i);
+            }
+        }
+        return removed;
+    }
+
+    bool Empty() const { return heap_.empty(); }
+
+    size_t Size() const { return heap_.size(); }
+
+private:
+    void SiftUp(size_t i) {
+        TimerEntry timer = heap_[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / kArity;
+            if (heap_[parent].first <= timer.first) {
+                break;
+            }
+            heap_[i] = heap_[parent];
+            i = parent;
+        }
+        heap_[i] = timer;
+    }
+
+    void SiftDown(size_t i) {
+        TimerEntry timer = heap_[i];
+        size_t size = heap_.size();
+        while (true) {
+            size_t first = i * kArity + 1;
+            if (first >= size) {
+                break;
+            }
+            size_t best = first;
+            for (size_t child = first + 1; child < std::min(first + kArity, size); ++child) {
+                if (heap_[child].first < heap_[best].first) {
+                    best = child;
+                }
+            }
+            if (heap_[best].first >= timer.first) {
+                break;
+            }
+            heap_[i] = heap_[best];
+            i = best;
+        }
+        heap_[i] = timer;
+    }
+
+private:
+    static constexpr size_t kArity = 4;
+    std::vector<TimerEntry> heap_;
+};
+
+}  // namespace asyncio
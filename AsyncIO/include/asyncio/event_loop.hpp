@@ -2,36 +2,77 @@
 
 #include <algorithm>
 #include <chrono>
+#include <array>
 #include <coroutine>
+#include <asyncio/cancellation.hpp>
+#include <asyncio/detail/budget.hpp>
+#include <asyncio/detail/busy_poll.hpp>
+#include <asyncio/detail/clock.hpp>
+#include <asyncio/detail/concepts/event_loop_policy.hpp>
+#include <asyncio/detail/config.hpp>
 #include <asyncio/detail/noncopyable.hpp>
+#include <asyncio/detail/probes.hpp>
+#include <asyncio/detail/ready_queue.hpp>
 #include <asyncio/detail/selector/selector.hpp>
+#include <asyncio/detail/timer_queue.hpp>
+#include <asyncio/exception.hpp>
 #include <asyncio/handle.hpp>
-#include <queue>
+#include <asyncio/metrics.hpp>
+#include <asyncio/task_accounting.hpp>
+#include <asyncio/trace.hpp>
+#include <asyncio/watchdog.hpp>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <unordered_set>
+#include <utility>
 
 namespace asyncio {
 
-class EventLoop : NonCopyable {
+template <typename SelectorPolicy, typename TimerPolicy, typename ReadyQueuePolicy,
+          typename ClockPolicy = ASYNCIO_CLOCK_POLICY>
+class BasicEventLoop;
+
+// 全局事件循环类型 (策略由 detail/config.hpp 中的宏选择)
+using EventLoop =
+    BasicEventLoop<ASYNCIO_SELECTOR_POLICY, ASYNCIO_TIMER_POLICY, ASYNCIO_READY_QUEUE_POLICY>;
+
+// 获取 EventLoop (线程安全单例)
+EventLoop& GetEventLoop();
+
+// 事件循环 (策略在编译期选择, 没有虚函数开销)
+// - SelectorPolicy: I/O 多路复用 (EpollSelector / PollSelector)
+// - TimerPolicy: 定时任务的有序集合 (HeapTimerQueue / QuadHeapTimerQueue)
+// - ReadyQueuePolicy: 就绪队列 (DequeReadyQueue / RingReadyQueue)
+// - ClockPolicy: 定时器使用的时钟 (MonotonicClock / CoarseMonotonicClock / TscClock)
+template <typename SelectorPolicy, typename TimerPolicy, typename ReadyQueuePolicy, typename ClockPolicy>
+class BasicEventLoop : NonCopyable {
+    static_assert(concepts::SelectorPolicy<SelectorPolicy>);
+    static_assert(concepts::TimerPolicy<TimerPolicy>);
+    static_assert(concepts::ReadyQueuePolicy<ReadyQueuePolicy>);
+    static_assert(concepts::ClockPolicy<ClockPolicy>);
+
     // NOTE: 事件循环内部推荐用 duration 相对时间
     // 只关心"距离启动多久后触发", 不关心绝对时间
-    using MSDuration = std::chrono::milliseconds;
+    using Duration = std::chrono::nanoseconds;
 
 public:
-    EventLoop() {
-        auto now = std::chrono::steady_clock::now();  // NOTE: steady_clock: 单调递增稳定时钟
-        start_time_ = duration_cast<MSDuration>(now.time_since_epoch());  // 初始化启动时间
-    }
+    BasicEventLoop() : start_time_(ClockPolicy::Now()) {}
 
-    // 返回当前相对启动时间 (毫秒)
-    MSDuration time() {
-        auto now = std::chrono::steady_clock::now();
-        return duration_cast<MSDuration>(now.time_since_epoch()) - start_time_;
-    }
+    ~BasicEventLoop() { DisableTracing(); }
+
+    // 返回相对启动时间 (纳秒)
+    // NOTE: 每次迭代只读一次时钟 (Select 返回后, 以及将要阻塞时), 同一次迭代中的回调看到同一个时间;
+    // 回调中长时间阻塞后再设置定时器时, 可先调用 UpdateTime()
+    Duration time() const { return now_; }
 
-    // 延迟一段时间后再调度
+    // 重新读取时钟, 更新 time()
+    void UpdateTime() { now_ = ClockPolicy::Now() - start_time_; }
+
+    // 延迟一段时间后再调度 (相对本次迭代的时间 time())
     template <typename Rep, typename Period>
     void CallLater(std::chrono::duration<Rep, Period> delay, Handle& callback) {
-        CallAt(time() + duration_cast<MSDuration>(delay), callback);
+        CallAt(time() + std::chrono::duration_cast<Duration>(delay), callback);
     }
 
     // 取消调度
@@ -42,67 +83,292 @@ public:
 
     // 立即调度 (加入 ready_)
     void CallSoon(Handle& handle) {
+        TraceBuffer::Emit(TraceEventType::SCHEDULE, handle.GetHandleId());
+        ASYNCIO_PROBE(call_soon, handle.GetHandleId());
         handle.SetState(Handle::SCHEDULED);
-        ready_.push({handle.GetHandleId(), &handle});
+        ready_.Push({handle.GetHandleId(), &handle});
     }
 
-    //
-    struct WaitEventAwaiter {
+    // 等待 IO 事件的可等待对象, 挂起期间观察协程的取消令牌
+    // NOTE: 可以是对象成员 (Stream 的读写事件在多次等待间保持注册), co_await 时经 operator co_await
+    //       在协程帧中创建 Awaiter, 协程挂起期间被销毁 (取消, 超时, WhenAny 的输家...) 时由它注销事件
+    struct WaitEventAwaiter : CancellationToken::Callback {
+        WaitEventAwaiter(BasicEventLoop& loop, Event const& event) : loop_(loop), event_(event) {}
+
+        // 协程帧中的可等待对象: 转发给 WaitEventAwaiter, 析构时协程仍挂起在其中则放弃等待
+        struct Awaiter {
+            bool await_ready() noexcept { return self_.await_ready(); }
+
+            template <typename Promise>
+            bool await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                return self_.await_suspend(handle);
+            }
+
+            void await_resume() { self_.await_resume(); }
+
+            ~Awaiter() {
+                if (self_.coro_) [[unlikely]] {
+                    self_.Abandon();
+                }
+            }
+
+            WaitEventAwaiter& self_;
+        };
+
+        Awaiter operator co_await() noexcept { return Awaiter{*this}; }
+
         bool await_ready() noexcept {
             // 指针自引用检测技巧, 哨兵值技术, 标记特殊状态(没有对应回调, 协程继续执行, 不需要挂起)
             bool ready = (event_.handle_info.handle == (Handle const*)&event_.handle_info.handle);
             event_.handle_info.handle = nullptr;
-            return ready;
+            // 操作预算耗尽: 照常挂起等待, 事件是水平触发的, 下次 Select 会再次报告
+            return ready && detail::OperationBudget::Consume();
         }
 
+        // 返回 false 表示不挂起 (令牌已被取消, await_resume 中抛出 CancelledError)
         template <typename Promise>
-        constexpr void await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        bool await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            token_ = handle.promise().cancel_token_;
+            if (token_ && token_->IsCancelled()) {
+                return false;
+            }
+            coro_ = &handle.promise();
             handle.promise().SetState(Handle::SUSPEND);  // 设置挂起状态
             event_.handle_info = {.id = handle.promise().GetHandleId(),
                                   // NOTE: 协程的 Promise 对象也是 Handle,
                                   // 因此这里将其注册为事件回调
                                   // 在 RunOnce() 中事件发生时会调用 Run() 方法
                                   .handle = &handle.promise()};
+            TraceBuffer::Emit(TraceEventType::IO_WAIT, event_.handle_info.id);
             if (!registered_) {
-                selector_.RegisterEvent(event_);  // 注册监听事件
+                loop_.selector_.RegisterEvent(event_);  // 注册监听事件
                 registered_ = true;
             }
+            if (token_) {
+                token_->Register(*this);
+            }
+            return true;
         }
 
-        void await_resume() noexcept {
+        void await_resume() {
             event_.handle_info = {};  //< reset callback
+            coro_ = nullptr;
+            Unlink();  // 从取消令牌上注销
+            if (auto token = std::exchange(token_, nullptr); token && token->IsCancelled()) {
+                throw CancelledError{};
+            }
+        }
+
+        // 令牌被取消: 注销 IO 事件 (下次等待时重新注册) 并唤醒挂起的协程
+        void OnCancel() override final {
+            Destroy();
+            event_.handle_info = {};
+            if (coro_->GetState() == Handle::SUSPEND) {  // SCHEDULED: 事件已就绪, 协程即将恢复
+                loop_.CallSoon(*coro_);
+            }
+        }
+
+        // 挂起的协程被销毁: 注销 IO 事件并清空回调, 从取消令牌上注销, 此后不再访问该协程
+        // NOTE: 已就绪 (SCHEDULED) 的协程由 CoroHandle::Cancel 从就绪队列中移除
+        void Abandon() noexcept {
+            Destroy();
+            event_.handle_info = {};
+            coro_ = nullptr;
+            token_ = nullptr;
+            Unlink();
         }
 
         // 移除注册事件
         void Destroy() noexcept {
             if (registered_) {
-                selector_.RemoveEvent(event_);
+                loop_.selector_.RemoveEvent(event_);
                 registered_ = false;
             }
         }
 
         ~WaitEventAwaiter() { Destroy(); }
 
-        Selector& selector_;
+        BasicEventLoop& loop_;
         Event event_{};
         bool registered_{false};
+        CoroHandle* coro_{};          // 挂起中的协程 (恢复或放弃等待时清空)
+        CancellationToken* token_{};  // 挂起期间观察的取消令牌
     };
 
     // 等待特定的 IO 事件 (返回 WaitEventAwaiter)
     [[nodiscard]]
     auto WaitEvent(Event const& event) {
-        return WaitEventAwaiter{selector_, event};
+        return WaitEventAwaiter{*this, event};
     }
 
     // 运行事件循环直到所有任务完成
-    void RunUntilComplete();
+    void RunUntilComplete() {
+        UpdateTime();  // 上次运行结束后可能已过去很久
+        while (!IsStop()) {  // NOTE: 这里 IsStop() 函数动态判断
+            RunOnce();
+        }
+    }
+
+    // 开启忙轮询: 将要阻塞在 Select 之前, 先以零超时轮询最多 spin 时长, 用 CPU 换取唤醒延迟
+    // (省去线程睡眠与唤醒, 适合独占核心的低延迟部署)
+    // adaptive: 按最近的事件到达间隔在 [0, spin] 内调整轮询时长, 事件稀疏时不再轮询
+    // (见 detail/busy_poll.hpp)
+    // NOTE: 有就绪回调时不轮询; 定时任务先于窗口到期时只轮询到定时任务到期
+    void EnableBusyPoll(std::chrono::nanoseconds spin = std::chrono::microseconds(50),
+                        bool adaptive = true) {
+        busy_poll_.Configure(spin, adaptive);
+    }
+
+    void DisableBusyPoll() { busy_poll_.Configure(Duration(0), false); }
+
+    bool IsBusyPollEnabled() const { return busy_poll_.Enabled(); }
+
+    // 各优先级每轮执行的句柄数 (加权轮转, 默认 HIGH 8 / NORMAL 4 / LOW 1), 权重至少为 1
+    void SetPriorityWeights(std::array<uint32_t, kPriorityCount> weights) {
+        if (std::ranges::find(weights, 0u) != weights.end()) {
+            throw std::invalid_argument("priority weight must be positive");
+        }
+        weights_ = weights;
+    }
+
+    // 每次迭代执行回调的时间片: 用完后剩余的就绪句柄留到下次迭代, 先检查 IO,
+    // 使后台任务积压时高优先级的 IO 也能及时执行; 0 表示不限制 (默认)
+    // NOTE: 开启后每轮读一次时钟
+    void SetTimeSlice(std::chrono::nanoseconds slice) { time_slice_ = std::max(slice, Duration(0)); }
+
+    // 协程每次恢复执行后不挂起就能完成的操作数 (已就绪的 IO, 通道, 同步原语), 超过后先让出一次
+    // 事件循环再返回结果; 0 表示不限制 (默认 ASYNCIO_OPERATION_BUDGET, 见 detail/budget.hpp)
+    void SetOperationBudget(uint32_t budget) { detail::OperationBudget::SetLimit(budget); }
+
+    uint32_t GetOperationBudget() const { return detail::OperationBudget::Limit(); }
+
+    // 运行期开启/关闭指标统计 (ASYNCIO_ENABLE_LOOP_METRICS 关闭时无效)
+    void EnableMetrics(bool enable = true) {
+        metrics_enabled_ = ASYNCIO_ENABLE_LOOP_METRICS && enable;
+    }
+
+    bool IsMetricsEnabled() const { return metrics_enabled_; }
+
+    // 指标快照 (计数器与直方图自开启或上次 ResetMetrics() 起累计)
+    LoopMetrics Metrics() const {
+        LoopMetrics snapshot = metrics_;
+        snapshot.ready_size = ready_.Size();
+        snapshot.timer_backlog = schedule_.Size();
+        snapshot.cancelled_backlog = cancelled_.size();
+        return snapshot;
+    }
+
+    // 清空计数器与直方图, 开始新的统计区间
+    void ResetMetrics() { metrics_ = LoopMetrics{}; }
+
+    // 开启协程生命周期跟踪 (ASYNCIO_ENABLE_TRACING 关闭时不记录任何事件)
+    // capacity: 环形缓冲区保留的事件数, 重新开启时清空之前的事件
+    void EnableTracing(size_t capacity = 1 << 16) {
+        DisableTracing();
+        trace_ = std::make_unique<TraceBuffer>(capacity);
+        trace_->Activate();
+    }
+
+    // 停止跟踪 (保留已记录的事件供导出)
+    void DisableTracing() {
+        if (trace_) {
+            trace_->Deactivate();
+        }
+    }
+
+    // 跟踪缓冲区 (从未开启时为 nullptr), 用 ToChromeJson() 导出
+    TraceBuffer const* GetTraceBuffer() const { return trace_.get(); }
+
+    // 开启慢回调检测: 单个回调耗时达到 threshold 时在事件循环线程中调用 handler
+    // (默认输出到 stderr 并打印协程的回溯栈; ASYNCIO_ENABLE_LOOP_DEBUG 关闭时无效)
+    void EnableSlowCallbackCheck(std::chrono::nanoseconds threshold = std::chrono::milliseconds(100),
+                                 SlowCallbackHandler handler = PrintSlowCallback) {
+        slow_callback_threshold_ = threshold;
+        slow_callback_handler_ = std::move(handler);
+        UpdateInstrumented();
+    }
+
+    void DisableSlowCallbackCheck() {
+        slow_callback_handler_ = nullptr;
+        UpdateInstrumented();
+    }
+
+    // 开启看门狗: 后台线程检测事件循环的一次迭代超过 timeout 仍未完成时, 在看门狗线程中调用 handler
+    // (默认输出到 stderr 并打印卡住的协程的回溯栈; ASYNCIO_ENABLE_LOOP_DEBUG 关闭时无效)
+    void EnableWatchdog(std::chrono::nanoseconds timeout = std::chrono::seconds(1),
+                        LoopStallHandler handler = PrintLoopStall) {
+        watchdog_.reset();
+        if (ASYNCIO_ENABLE_LOOP_DEBUG) {
+            watchdog_ = std::make_unique<Watchdog>(timeout, std::move(handler));
+        }
+        UpdateInstrumented();
+    }
+
+    // 停止看门狗 (等待看门狗线程退出)
+    void DisableWatchdog() {
+        watchdog_.reset();
+        UpdateInstrumented();
+    }
+
+    // 开启任务 CPU 时间统计 (见 task_accounting.hpp), 重新开启时清空之前的统计
+    // (ASYNCIO_ENABLE_LOOP_DEBUG 关闭时无效)
+    void EnableTaskAccounting() {
+        DisableTaskAccounting();
+        accounting_ = std::make_unique<TaskAccounting>();
+        if (ASYNCIO_ENABLE_LOOP_DEBUG) {
+            accounting_->Activate();
+            accounting_enabled_ = true;
+        }
+        UpdateInstrumented();
+    }
+
+    // 停止统计 (保留已有的统计供查询)
+    void DisableTaskAccounting() {
+        if (accounting_) {
+            accounting_->Deactivate();
+        }
+        accounting_enabled_ = false;
+        UpdateInstrumented();
+    }
+
+    // 任务统计 (从未开启时为 nullptr), 用 Top() 查询占用 CPU 最多的标签
+    TaskAccounting const* GetTaskAccounting() const { return accounting_.get(); }
+
+    // 清空任务统计, 开始新的统计区间
+    void ResetTaskAccounting() {
+        if (accounting_) {
+            accounting_->Reset();
+        }
+    }
 
 private:
     // 判断事件循环是否停止
-    bool IsStop() { return schedule_.empty() && ready_.empty() && selector_.IsStop(); }
+    bool IsStop() { return schedule_.Empty() && ready_.Empty() && selector_.IsStop(); }
 
-    // 清理已取消的定时任务
-    void CleanupDelayedCall();
+    // 清理已取消的定时任务 (堆顶逐个弹出, 堆中积压过多时整体压缩)
+    void CleanupDelayedCall() {
+        // 移除被取消的回调
+        while (!schedule_.Empty()) {
+            if (auto iter = cancelled_.find(schedule_.Top().second.id); iter != cancelled_.end()) {
+                schedule_.Pop();
+                cancelled_.erase(iter);
+            } else {
+                break;
+            }
+        }
+
+        // 堆顶之下也可能积压已取消的定时任务 (例如 WhenAny 取消的任务中尚未到期的 Sleep),
+        // 它们会一直占用内存并使 IsStop() 为假: 新增的取消数超过堆大小的一半时整体移除并重建堆,
+        // 均摊复杂度 O(1)
+        if (cancelled_.size() < compacted_cancelled_) {
+            compacted_cancelled_ = cancelled_.size();
+        }
+        if (!schedule_.Empty() && cancelled_.size() - compacted_cancelled_ > schedule_.Size() / 2) {
+            schedule_.EraseIf(
+                [this](TimerEntry const& timer) { return cancelled_.erase(timer.second.id) > 0; });
+            compacted_cancelled_ = cancelled_.size();
+        }
+    }
 
     // 在指定时间点执行任务, 加入定时任务堆
     // when: 希望回调被调度的相对时间
@@ -110,26 +376,297 @@ private:
     template <typename Rep, typename Period>
     void CallAt(std::chrono::duration<Rep, Period> when, Handle& callback) {
         callback.SetState(Handle::SCHEDULED);  // 设置被调度状态
-        // 加入定时任务队
-        schedule_.emplace_back(duration_cast<MSDuration>(when),
-                               HandleInfo{callback.GetHandleId(), &callback});
-        // 保证最小堆的堆顶是最早到期()的任务
-        std::ranges::push_heap(schedule_, std::ranges::greater{}, &TimerHandle::first);
+        // 加入定时任务队 (堆顶是最早到期的任务)
+        schedule_.Push({std::chrono::duration_cast<Duration>(when),
+                        HandleInfo{callback.GetHandleId(), &callback}});
     }
 
     // 执行事件循环的一次迭代
-    void RunOnce();
+    // NOTE: 开启指标统计或逐个回调的检测 (慢回调, 看门狗, 任务统计) 时走单独实例化的版本,
+    // 未开启时每次迭代只多一次分支判断
+    void RunOnce() {
+        bool metrics = ASYNCIO_ENABLE_LOOP_METRICS && metrics_enabled_;
+        if (instrumented_) [[unlikely]] {
+            metrics ? RunOnce<true, true>() : RunOnce<false, true>();
+        } else if (metrics) [[unlikely]] {
+            RunOnce<true, false>();
+        } else {
+            RunOnce<false, false>();
+        }
+    }
+
+    template <bool kMetrics, bool kInstrumented>
+    void RunOnce() {
+        using Clock = std::chrono::steady_clock;
+        [[maybe_unused]] Clock::time_point iteration_start, select_end;
+        ASYNCIO_PROBE(iteration_start, ready_.Size(), schedule_.Size());
+        Duration timeout{-1};  // 调用 selector_.Select() 的最大阻塞时间, 负数表示无限等待
+        if (!ready_.Empty()) {  // 就绪队列非空,
+            timeout = Duration(0);
+        } else if (!schedule_.Empty()) {
+            UpdateTime();  // 将要阻塞: 按当前时间计算到最早的定时任务的等待时间
+            auto&& [when, _] = schedule_.Top();  // 最小堆的堆顶: 过期时间最早
+            timeout = std::max(when - time(), Duration(0));
+        }
+
+        // 这里如果 timeout = 0 那就直接不阻塞了
+        // 如果 timeout > 0 那么就会阻塞一会获取事件, 然后 schedule_ 中任务就 ready 了
+        if constexpr (kMetrics) {
+            iteration_start = Clock::now();
+        }
+        auto event_lists = busy_poll_.Enabled() && timeout != Duration(0)
+                               ? BusyPoll<kMetrics>(timeout)
+                               : selector_.Select(timeout);
+        ASYNCIO_PROBE(select_return, event_lists.size(), timeout.count());
+        if constexpr (kMetrics) {
+            select_end = Clock::now();
+            metrics_.select_time.Record(select_end - iteration_start);
+            metrics_.io_events += event_lists.size();
+        }
+        if constexpr (kInstrumented) {
+            if (watchdog_) {
+                watchdog_->BeginIteration();
+            }
+        }
+
+        // NOTE: 范围 for 循环中 auto&& 是万能引用
+        for (auto&& event : event_lists) {
+            auto [handle_id, handle] = event.handle_info;
+            // 已取消的句柄可能已销毁, 不能访问 (它在 ready_ 中的记录由 cancelled_ 跳过)
+            if (!cancelled_.empty() && cancelled_.contains(handle_id)) [[unlikely]] {
+                continue;
+            }
+            // 已在 ready_ 中 (时间片用完时留下的): 水平触发的事件再次报告, 不能重复加入
+            if (handle->GetState() == Handle::SCHEDULED) {
+                continue;
+            }
+            // 标记为 SCHEDULED: 同一轮中被取消唤醒 (WaitEventAwaiter::OnCancel) 时不会重复加入 ready_
+            handle->SetState(Handle::SCHEDULED);
+            ready_.Push(event.handle_info);  // 把这次 epoll_wait 监听到的发生事件对应的回调加入 ready_
+        }
+
+        UpdateTime();  // 本次迭代的时间: 定时任务到期判断与回调中的 CallLater 共用
+        auto end_time = time();
+        while (!schedule_.Empty()) {
+            // 最小堆的堆顶: 过期时间最早 (刚刚 epoll_wait 了这个时间)
+            auto&& [when, handle_info] = schedule_.Top();
+            if (when > end_time) {  // 如果遇到了还没过期的, 就退出循环
+                break;
+            }
+            // 已取消的定时任务直接丢弃 (句柄可能已销毁, 不能按其优先级入队)
+            if (!cancelled_.empty()) {
+                if (auto iter = cancelled_.find(handle_info.id); iter != cancelled_.end()) {
+                    cancelled_.erase(iter);
+                    schedule_.Pop();
+                    if constexpr (kMetrics) {
+                        ++metrics_.cancelled_skipped;
+                    }
+                    continue;
+                }
+            }
+            TraceBuffer::Emit(TraceEventType::TIMER, handle_info.id);
+            ASYNCIO_PROBE(timer_fire, handle_info.id);
+            ready_.Push(handle_info);  // 把过期的加入 ready_ 马上执行
+            schedule_.Pop();           // 去除堆顶
+            if constexpr (kMetrics) {
+                ++metrics_.timers_fired;
+            }
+        }
+
+        [[maybe_unused]] uint64_t callbacks = 0;
+        [[maybe_unused]] Clock::time_point callback_start;
+        if constexpr (kMetrics) {
+            metrics_.ready_depth.Record(uint64_t{ready_.Size()});
+            callback_start = Clock::now();
+        }
+
+        auto run = [&](HandleInfo info) {
+            auto [handle_id, handle] = info;
+            // 如果当前 handle 是应该取消的, 那么就从 cancelled_ 中移除, 并跳过执行
+            // NOTE: 没有任何取消时跳过哈希查找
+            if (!cancelled_.empty()) {
+                if (auto iter = cancelled_.find(handle_id); iter != cancelled_.end()) {
+                    cancelled_.erase(iter);
+                    if constexpr (kMetrics) {
+                        ++metrics_.cancelled_skipped;
+                    }
+                    return;
+                }
+            }
+            handle->SetState(Handle::UNSCHEDULED);
+            ASYNCIO_PROBE(handle_run_entry, handle_id, handle->IsCoroutine());
+            // 协程句柄直接恢复协程帧 (一次间接调用), 其他句柄 (定时器等) 经过虚函数 Run()
+            if constexpr (kInstrumented) {
+                RunInstrumented(handle_id, handle);
+            } else if (handle->IsCoroutine()) {
+                static_cast<CoroHandle*>(handle)->Resume();
+            } else {
+                handle->Run();
+            }
+            ASYNCIO_PROBE(handle_run_exit, handle_id);
+            if constexpr (kMetrics) {
+                auto callback_end = Clock::now();
+                metrics_.callback_time.Record(callback_end - callback_start);
+                callback_start = callback_end;
+                ++callbacks;
+            }
+        };
+
+        // 只执行本次迭代开始时已就绪的句柄 (回调中新加入的留到下次迭代)
+        // 各优先级加权轮转: 每轮 HIGH / NORMAL / LOW 依次最多执行 weights_ 个,
+        // 低优先级每轮都能执行, 不会饿死
+        std::array<size_t, kPriorityCount> todo;
+        for (size_t lane = 0; lane < kPriorityCount; ++lane) {
+            todo[lane] = ready_.Size(lane);
+        }
+        size_t ntodo = ready_.Size();
+        size_t left = ntodo;
+        bool sliced = time_slice_ > Duration(0);
+        Duration slice_end = sliced ? ClockPolicy::Now() + time_slice_ : Duration::max();
+        while (left > 0) {
+            for (size_t lane = 0; lane < kPriorityCount; ++lane) {
+                // 只剩一条队列且不限时间片时不必轮转
+                size_t n = (todo[lane] == left && !sliced)
+                               ? left
+                               : std::min<size_t>(todo[lane], weights_[lane]);
+                todo[lane] -= n;
+                left -= n;
+                for (; n > 0; --n) {
+                    run(ready_.Pop(lane));
+                }
+            }
+            // 时间片用完: 剩余的句柄留在就绪队列中, 先检查 IO (至少执行完一轮)
+            if (sliced && left > 0 && ClockPolicy::Now() >= slice_end) {
+                ntodo -= left;
+                if constexpr (kMetrics) {
+                    ++metrics_.time_slices_expired;
+                }
+                break;
+            }
+        }
+
+        CleanupDelayedCall();
+        ASYNCIO_PROBE(iteration_end, ntodo);
+
+        if constexpr (kMetrics) {
+            ++metrics_.iterations;
+            metrics_.callbacks += callbacks;
+            metrics_.callbacks_per_iteration.Record(callbacks);
+            metrics_.iteration_time.Record(Clock::now() - select_end);
+        }
+        if constexpr (kInstrumented) {
+            if (watchdog_) {
+                watchdog_->EndIteration();
+            }
+        }
+    }
+
+    // 忙轮询: 在窗口内以零超时轮询, 没有事件时阻塞等待剩余的时间
+    template <bool kMetrics>
+    auto BusyPoll(Duration timeout) {
+        auto window = busy_poll_.Window();
+        if (timeout >= Duration(0)) {
+            window = std::min(window, timeout);
+        }
+        auto start = ClockPolicy::Now();
+        if (window > Duration(0)) {
+            auto deadline = start + window;
+            do {
+                auto event_lists = selector_.Select(Duration(0));
+                if (!event_lists.empty()) {
+                    if constexpr (kMetrics) {
+                        ++metrics_.busy_poll_hits;
+                    }
+                    return event_lists;
+                }
+            } while (ClockPolicy::Now() < deadline);
+            if constexpr (kMetrics) {
+                ++metrics_.busy_poll_misses;
+            }
+        }
+        if (timeout > Duration(0)) {
+            timeout = std::max(timeout - (ClockPolicy::Now() - start), Duration(0));
+        }
+        auto event_lists = selector_.Select(timeout);
+        busy_poll_.OnBlocked(ClockPolicy::Now() - start, !event_lists.empty());
+        return event_lists;
+    }
+
+    // 逐个回调检测时执行一个回调: 发布正在运行的回调供看门狗读取, 计时, 报告慢回调并统计任务时间
+    void RunInstrumented(HandleId handle_id, Handle* handle) {
+        using Clock = std::chrono::steady_clock;
+        std::source_location location{};
+        CoroHandle* coro = nullptr;  // NOTE: 非协程句柄在 Run() 后可能已销毁
+        if (handle->IsCoroutine()) {
+            coro = static_cast<CoroHandle*>(handle);
+#if ASYNCIO_ENABLE_FRAME_INFO
+            location = coro->GetFrameInfo();  // 协程在回调中被销毁后仍可报告位置
+#endif
+            CoroHandle::watched_ = coro;
+        }
+        if (watchdog_) {
+            watchdog_->BeginCallback(handle_id, coro);
+        }
+
+        auto start = Clock::now();
+        uint32_t label = 0;
+        bool accounting = accounting_enabled_;
+        if (accounting) {
+            label = accounting_->BeginRun(coro, start);
+        }
+        if (coro) {
+            coro->Resume();
+        } else {
+            handle->Run();
+        }
+        auto end = Clock::now();
+        auto duration = end - start;
+
+        // 协程在回调中被销毁时 ~CoroHandle() 已清空 watched_
+        auto coroutine = std::exchange(CoroHandle::watched_, nullptr);
+        if (accounting && accounting_enabled_) {  // NOTE: 回调中可能停止统计
+            accounting_->EndRun(label, coroutine, start, end);
+        }
+        if (slow_callback_handler_ && duration >= slow_callback_threshold_) [[unlikely]] {
+            slow_callback_handler_({
+                .id = handle_id,
+                .duration = duration,
+                .location = location,
+                .coroutine = coroutine,
+            });
+        }
+    }
+
+    // 是否走逐个回调检测的 RunOnce()
+    void UpdateInstrumented() {
+        instrumented_ =
+            ASYNCIO_ENABLE_LOOP_DEBUG && (slow_callback_handler_ || watchdog_ || accounting_enabled_);
+    }
 
 private:
-    using TimerHandle = std::pair<MSDuration, HandleInfo>;  // <过期时间, 回调信息>
-    MSDuration start_time_;                   // 事件循环启动时间? 咋是 duration 而不是 time_point?
-    Selector selector_;                       // 事件选择器 epoll poller
-    std::queue<HandleInfo> ready_;            // 就绪队列, 存放已准备好可以立即执行的回调 (Handle)
-    std::vector<TimerHandle> schedule_;       // 最小堆, 按 pair 中的时间排序, 管理所有定时任务
+    Duration start_time_;                     // 事件循环启动时的时钟读数 (ClockPolicy::Now())
+    Duration now_{0};                         // 本次迭代的时间 (相对启动时间, 见 time())
+    SelectorPolicy selector_;                 // 事件选择器 (epoll/poll)
+    detail::ReadyLanes<ReadyQueuePolicy> ready_;  // 就绪队列 (每个优先级一条), 可以立即执行的回调
+    std::array<uint32_t, kPriorityCount> weights_{8, 4, 1};  // 各优先级每轮执行的句柄数
+    Duration time_slice_{0};                  // 每次迭代执行回调的时间片, 0 表示不限制
+    TimerPolicy schedule_;                    // 按到期时间排序, 管理所有定时任务
     std::unordered_set<HandleId> cancelled_;  // 被取消的回调的 ID (判断是否被取消, 避免错误执行)
+    size_t compacted_cancelled_{0};           // 上次压缩定时任务堆后 cancelled_ 的大小
+    detail::BusyPollWindow busy_poll_;        // 忙轮询窗口 (EnableBusyPoll)
+    bool metrics_enabled_{false};             // 是否统计指标 (EnableMetrics)
+    LoopMetrics metrics_;                     // 指标 (计数器与直方图)
+    std::unique_ptr<TraceBuffer> trace_;      // 跟踪事件缓冲区 (EnableTracing)
+    bool instrumented_{false};                // 是否开启慢回调检测, 看门狗或任务统计
+    std::chrono::nanoseconds slow_callback_threshold_{};  // 慢回调阈值 (EnableSlowCallbackCheck)
+    SlowCallbackHandler slow_callback_handler_;           // 慢回调处理函数 (为空表示不检测)
+    std::unique_ptr<Watchdog> watchdog_;                  // 看门狗 (EnableWatchdog)
+    std::unique_ptr<TaskAccounting> accounting_;          // 任务统计 (EnableTaskAccounting)
+    bool accounting_enabled_{false};                      // 是否正在统计
 };
 
-// 获取 EventLoop (线程安全单例)
-EventLoop& GetEventLoop();
+// 全局事件循环在 event_loop.cpp 中显式实例化
+extern template class BasicEventLoop<ASYNCIO_SELECTOR_POLICY, ASYNCIO_TIMER_POLICY,
+                                     ASYNCIO_READY_QUEUE_POLICY>;
 
 }  // namespace asyncio
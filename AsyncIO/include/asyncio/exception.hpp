@@ -12,6 +12,14 @@ struct NoResultError : std::exception {
     [[nodiscard]] char const* what() const noexcept override { return "Result is unset!"; }
 };
 
+struct CancelledError : std::exception {
+    [[nodiscard]] char const* what() const noexcept override { return "Cancelled!"; }
+};
+
+struct ChannelClosedError : std::exception {
+    [[nodiscard]] char const* what() const noexcept override { return "Channel is closed!"; }
+};
+
 struct InvalidFuture : std::exception {
     [[nodiscard]] char const* what() const noexcept override { return "Future is invalid!"; }
 };
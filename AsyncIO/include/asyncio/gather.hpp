@@ -1,14 +1,21 @@
 /**
  *  允许并发执行多个可等待对象 (Awaitable), 并将它们的结果收集到一个元组中.
  *  当所有任务完成或任一任务抛出异常时, 整个gather操作完成.
+ *
+ *  GatherAll: 运行时数量的同类型任务, 结果收集到 std::vector 中.
+ *  MapConcurrent: 对范围中每个元素执行异步函数, 同时存活的任务数不超过 max_in_flight.
  */
 
 #pragma once
 
 // std
+#include <algorithm>
+#include <functional>
+#include <ranges>
 #include <stdexcept>
 #include <tuple>
 #include <variant>
+#include <vector>
 // asyncio
 #include <asyncio/detail/concepts/awaitable.hpp>
 #include <asyncio/detail/noncopyable.hpp>
@@ -68,8 +75,9 @@ private:
         } catch (...) {
             result_ = std::current_exception();
         }
-        if (IsFinished()) {
-            GetEventLoop().CallSoon(*continuation_);
+        // NOTE: 异常完成后其余任务仍可能结束, continuation_ 只能被唤醒一次
+        if (IsFinished() && continuation_) {
+            GetEventLoop().CallSoon(*std::exchange(continuation_, nullptr));
         }
     }
 
@@ -119,6 +127,120 @@ auto Gather(NoWaitAtInitialSuspend,
     co_return co_await GatherAwaiterRepositry{std::forward<Futs>(futs)...};
 }
 
+// 运行时数量的同类型任务: 结果存放在 std::vector 中, 只用一个完成计数器
+template <typename R>
+class GatherAllAwaiter : NonCopyable {
+    using ResultType = std::conditional_t<std::is_void_v<R>, VoidValue, std::vector<R>>;
+
+public:
+    explicit GatherAllAwaiter(std::vector<Task<R>>& futs) : total_(futs.size()) {
+        if constexpr (!std::is_void_v<R>) {
+            std::get<ResultType>(result_).resize(futs.size());
+        }
+        tasks_.reserve(futs.size());
+        for (size_t i = 0; i < futs.size(); ++i) {
+            tasks_.push_back(CollectResult(no_wait_at_initial_suspend, futs[i], i));
+        }
+    }
+
+    constexpr bool await_ready() noexcept { return IsFinished(); }
+
+    auto await_resume() {
+        if (auto exception = std::get_if<std::exception_ptr>(&result_)) {
+            std::rethrow_exception(*exception);
+        }
+        if constexpr (!std::is_void_v<R>) {
+            return std::move(std::get<ResultType>(result_));
+        }
+    }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> continuation) noexcept {
+        continuation_ = &continuation.promise();
+        continuation_->SetState(Handle::SUSPEND);
+    }
+
+private:
+    Task<> CollectResult(NoWaitAtInitialSuspend, Task<R>& fut, size_t idx) {
+        try {
+            if constexpr (std::is_void_v<R>) {
+                co_await std::move(fut);
+            } else {
+                auto& results = std::get<ResultType>(result_);
+                results[idx] = co_await std::move(fut);
+            }
+            ++count_;
+        } catch (...) {
+            result_ = std::current_exception();
+        }
+        if (IsFinished() && continuation_) {
+            GetEventLoop().CallSoon(*std::exchange(continuation_, nullptr));
+        }
+    }
+
+    bool IsFinished() {
+        return (count_ == total_ || std::get_if<std::exception_ptr>(&result_) != nullptr);
+    }
+
+private:
+    std::variant<ResultType, std::exception_ptr> result_;
+    std::vector<Task<>> tasks_;
+    CoroHandle* continuation_{};
+    size_t total_;
+    size_t count_{0};
+};
+
+template <typename R>
+auto GatherAll(NoWaitAtInitialSuspend, std::vector<Task<R>> futs)
+    -> Task<std::conditional_t<std::is_void_v<R>, void, std::vector<R>>> {
+    co_return co_await GatherAllAwaiter<R>{futs};
+}
+
+template <typename Range, typename Fn>
+using MapResult = AwaitResult<std::invoke_result_t<Fn&, std::ranges::range_reference_t<Range>>>;
+
+// MapConcurrent 的工作协程: 不断从共享游标取下一个元素执行, 直到范围耗尽
+template <typename View, typename Fn, typename Results>
+Task<> MapWorker(std::ranges::iterator_t<View>& iter, View& view, size_t& next_index, Fn& fn,
+                 Results& results) {
+    while (iter != std::ranges::end(view)) {
+        auto idx = next_index++;
+        auto&& elem = *iter;
+        ++iter;  // NOTE: forward_range 保证推进迭代器后 elem 仍然有效
+        if constexpr (std::is_void_v<MapResult<View, Fn>>) {
+            co_await std::invoke(fn, elem);
+        } else {
+            results[idx] = co_await std::invoke(fn, elem);
+        }
+    }
+}
+
+template <std::ranges::forward_range Range, typename Fn,
+          typename R = MapResult<std::ranges::views::all_t<Range>, Fn>>
+auto MapConcurrent(NoWaitAtInitialSuspend, Range&& range, Fn fn, size_t max_in_flight)
+    -> Task<std::conditional_t<std::is_void_v<R>, void, std::vector<R>>> {
+    // 右值范围被移入 owning_view, 左值范围只保存引用
+    auto view = std::views::all(std::forward<Range>(range));
+    auto size = static_cast<size_t>(std::ranges::distance(view));
+    std::conditional_t<std::is_void_v<R>, VoidValue, std::vector<R>> results{};
+    if constexpr (!std::is_void_v<R>) {
+        results.resize(size);
+    }
+
+    auto iter = std::ranges::begin(view);
+    size_t next_index = 0;
+    auto worker_count = std::clamp<size_t>(max_in_flight, 1, std::max<size_t>(size, 1));
+    std::vector<Task<>> workers;
+    workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers.push_back(MapWorker(iter, view, next_index, fn, results));
+    }
+    co_await GatherAll(no_wait_at_initial_suspend, std::move(workers));
+    if constexpr (!std::is_void_v<R>) {
+        co_return results;
+    }
+}
+
 }  // namespace detail
 
 template <concepts::Awaitable... Futs>
@@ -127,4 +249,22 @@ auto Gather(Futs&&... futs) {
     return detail::Gather(no_wait_at_initial_suspend, std::forward<Futs>(futs)...);
 }
 
+// 并发执行运行时数量的任务, 按输入顺序返回结果 (Task<void> 时无返回值)
+// 任一任务抛出异常时整个操作以该异常完成
+template <typename R>
+[[nodiscard("discard gather doesn't make sense")]]
+auto GatherAll(std::vector<Task<R>> futs) {
+    return detail::GatherAll(no_wait_at_initial_suspend, std::move(futs));
+}
+
+// 对 range 中每个元素调用 fn (返回可等待对象), 同时进行中的调用不超过 max_in_flight 个,
+// 按输入顺序返回结果. 只会创建 max_in_flight 个工作协程, 内存占用与 range 大小无关
+// (结果数组除外). NOTE: 左值 range 必须在 co_await 完成前保持有效
+template <std::ranges::forward_range Range, typename Fn>
+[[nodiscard("discard map doesn't make sense")]]
+auto MapConcurrent(Range&& range, Fn fn, size_t max_in_flight) {
+    return detail::MapConcurrent(no_wait_at_initial_suspend, std::forward<Range>(range),
+                                 std::move(fn), max_in_flight);
+}
+
 }  // namespace asyncio
\ No newline at end of file
@@ -0,0 +1,210 @@
+/**
+ *  异步生成器: 协程体中用 co_yield 逐个产出数据, 消费者按需拉取 (背压: 生产者在每个 co_yield
+ *  处挂起, 直到消费者请求下一个值), 流式处理大结果集时内存占用恒定.
+ *
+ *  auto gen = ReadRecords();
+ *  while (auto record = co_await gen.Next()) { ... }
+ *
+ *  // C++20 没有 for co_await, 迭代器写法:
+ *  for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) { ... *it ... }
+ */
+
+#pragma once
+
+// std
+#include <cassert>
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <source_location>
+#include <utility>
+// asyncio
+#include <asyncio/detail/noncopyable.hpp>
+#include <asyncio/event_loop.hpp>
+#include <asyncio/exception.hpp>
+#include <asyncio/handle.hpp>
+
+namespace asyncio {
+
+template <typename T>
+class AsyncGenerator : NonCopyable {
+public:
+    struct promise_type;
+    using coro_handle = std::coroutine_handle<promise_type>;
+
+    // 生成器的 promise 也是 CoroHandle: 由事件循环调度, 并继承创建者的取消令牌
+    struct promise_type : CoroHandle {
+#if ASYNCIO_ENABLE_FRAME_INFO
+        promise_type(std::source_location loc = std::source_location::current()) : frame_info_(loc) {}
+#else
+        promise_type() = default;
+#endif
+
+        auto get_return_object() noexcept {
+            auto handle = coro_handle::from_promise(*this);
+            frame_ = handle.address();
+            return AsyncGenerator{handle};
+        }
+
+        // 惰性启动: 第一次 Next() 时才开始执行
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        // co_yield 与协程结束时: 挂起生产者并唤醒等待的消费者
+        struct ResumeConsumer {
+            constexpr bool await_ready() const noexcept { return false; }
+
+            void await_suspend(coro_handle h) const noexcept {
+                auto& promise = h.promise();
+                promise.SetState(Handle::SUSPEND);
+                if (auto consumer = std::exchange(promise.consumer_, nullptr)) {
+                    GetEventLoop().CallSoon(*consumer);
+                }
+            }
+
+            constexpr void await_resume() const noexcept {}
+        };
+
+        ResumeConsumer final_suspend() noexcept { return {}; }
+
+        template <std::convertible_to<T> U>
+        ResumeConsumer yield_value(U&& value) {
+            current_.emplace(std::forward<U>(value));
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+#if ASYNCIO_ENABLE_FRAME_INFO
+        std::source_location const& GetFrameInfo() const override final { return frame_info_; }
+#endif
+
+        CoroHandle const* Continuation() const override final { return consumer_; }
+
+        void DumpBacktrace(size_t depth = 0) const override final {
+            fmt::println("[{}] {}", depth, FrameName());
+            if (consumer_) {
+                consumer_->DumpBacktrace(depth + 1);
+            } else {
+                fmt::println("");
+            }
+        }
+
+        std::optional<T> current_;      // 最近一次 co_yield 的值 (等待消费者取走)
+        std::exception_ptr exception_;  // 生产者抛出的异常
+        CoroHandle* consumer_{};        // 等待下一个值的消费者
+#if ASYNCIO_ENABLE_FRAME_INFO
+        std::source_location frame_info_;
+#endif
+    };
+
+private:
+    // 请求下一个值: 调度生产者运行到下一个 co_yield (或结束)
+    struct NextAwaiter {
+        bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+
+        template <typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> caller) noexcept {
+            auto& producer = handle_.promise();
+            assert(!producer.consumer_ && "AsyncGenerator: concurrent Next()");
+            caller.promise().SetState(Handle::SUSPEND);
+            producer.consumer_ = &caller.promise();
+            GetEventLoop().CallSoon(producer);
+        }
+
+        // 返回下一个值, 生成器结束时返回 std::nullopt
+        std::optional<T> await_resume() {
+            if (!handle_) [[unlikely]] {
+                throw InvalidFuture{};
+            }
+            auto& producer = handle_.promise();
+            if (producer.exception_) {
+                std::rethrow_exception(std::exchange(producer.exception_, nullptr));
+            }
+            return std::exchange(producer.current_, std::nullopt);
+        }
+
+        coro_handle handle_;
+    };
+
+public:
+    // 输入迭代器, 自增需要 co_await
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        explicit Iterator(AsyncGenerator& gen) : gen_(&gen) {}
+
+        T& operator*() const { return *gen_->value_; }
+
+        T* operator->() const { return &*gen_->value_; }
+
+        // co_await ++it
+        [[nodiscard]]
+        auto operator++() {
+            return gen_->Advance();
+        }
+
+        bool operator==(std::default_sentinel_t) const { return !gen_->value_; }
+
+    private:
+        AsyncGenerator* gen_;
+    };
+
+    // 拉取一个值并返回指向它的迭代器
+    struct AdvanceAwaiter : NextAwaiter {
+        Iterator await_resume() {
+            gen_.value_ = NextAwaiter::await_resume();
+            return Iterator{gen_};
+        }
+
+        AsyncGenerator& gen_;
+    };
+
+public:
+    explicit AsyncGenerator(coro_handle h) noexcept : handle_(h) {}
+
+    AsyncGenerator(AsyncGenerator&& other) noexcept
+        : handle_(std::exchange(other.handle_, {})), value_(std::move(other.value_)) {}
+
+    ~AsyncGenerator() { Destroy(); }
+
+public:
+    // 拉取下一个值: co_await gen.Next(), 结束时返回 std::nullopt, 生产者的异常在这里重新抛出
+    [[nodiscard]]
+    auto Next() {
+        return NextAwaiter{handle_};
+    }
+
+    // co_await gen.begin()
+    [[nodiscard]]
+    auto begin() {
+        return Advance();
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+    bool IsValid() const { return handle_ != nullptr; }
+
+private:
+    AdvanceAwaiter Advance() { return AdvanceAwaiter{{handle_}, *this}; }
+
+    // 取消调度并销毁生产者协程
+    void Destroy() {
+        if (auto handle{std::exchange(handle_, nullptr)}) {
+            handle.promise().Cancel();
+            handle.destroy();
+        }
+    }
+
+private:
+    coro_handle handle_;      // 生产者协程句柄
+    std::optional<T> value_;  // 迭代器当前指向的值
+};
+
+}  // namespace asyncio
@@ -1,16 +1,34 @@
 #pragma once
 
-#include <fmt/core.h>
+#include <fmt/format.h>
 
+#include <coroutine>
 #include <cstdint>
 #include <source_location>
+#include <utility>
+//
+#include <asyncio/context.hpp>
+#include <asyncio/detail/budget.hpp>
+#include <asyncio/detail/config.hpp>
+#include <asyncio/task_accounting.hpp>
+#include <asyncio/trace.hpp>
 
 namespace asyncio {
 
 using HandleId = uint64_t;  // 句柄 ID 数据类型
 
+class CancellationToken;
+
+// 调度优先级: 就绪队列按优先级分道, 事件循环按权重轮转执行 (见 EventLoop::SetPriorityWeights)
+enum class Priority : uint8_t {
+    HIGH,    // 健康检查, 控制消息, 延迟敏感的响应
+    NORMAL,  // 默认
+    LOW,     // 批量传输, 后台任务
+};
+
+inline constexpr size_t kPriorityCount = 3;
+
 // 句柄基类
-// TODO: event_loop 类型擦除?
 struct Handle {
     // 句柄状态
     enum State : uint8_t {
@@ -19,7 +37,9 @@ struct Handle {
         SCHEDULED,    // 调度中
     };
 
-    Handle() noexcept : handle_id_(handle_id_generation_++) {}
+    // NOTE: 优先级继承自当前正在运行的协程 (例如 Sleep 的定时器与所在协程同一优先级)
+    Handle() noexcept
+        : handle_id_(handle_id_generation_++), priority_(static_cast<uint8_t>(current_priority_)) {}
 
     virtual ~Handle() = default;
 
@@ -29,15 +49,42 @@ struct Handle {
     // 设置句柄状态: (UNSCHEDULED SUSPEND SCHEDULED)
     void SetState(State state) { state_ = state; }
 
+    // 获取句柄状态
+    State GetState() const { return state_; }
+
     HandleId GetHandleId() { return handle_id_; }
 
+    // 调度优先级 (决定进入哪条就绪队列)
+    Priority GetPriority() const { return static_cast<Priority>(priority_); }
+
+    void SetPriority(Priority priority) { priority_ = static_cast<uint8_t>(priority); }
+
+    // 是否为协程句柄 (CoroHandle): 事件循环直接恢复协程, 不经过虚函数 Run()
+    bool IsCoroutine() const { return coroutine_; }
+
+protected:
+    struct CoroutineTag {};
+
+    // CoroHandle 的构造函数
+    explicit Handle(CoroutineTag) noexcept
+        : handle_id_(handle_id_generation_++),
+          priority_(static_cast<uint8_t>(current_priority_)),
+          coroutine_(true) {}
+
+public:
+    // 当前正在运行的协程的优先级 (由 CoroHandle::Resume() 维护, 协程外为 NORMAL)
+    inline static Priority current_priority_{Priority::NORMAL};
+
 private:
-    HandleId handle_id_;  // 句柄 ID
+    // NOTE: 句柄 ID, 优先级, 协程标记与状态共用 8 字节 (2^53 个 ID 足够事件循环的整个生命周期)
+    HandleId handle_id_ : 53;     // 句柄 ID
+    uint8_t priority_ : 2;        // 调度优先级 (Priority)
+    bool coroutine_ : 1 {false};  // 是否为协程句柄
 
     inline static HandleId handle_id_generation_ = 0;
 
 protected:
-    State state_{Handle::UNSCHEDULED};  // 句柄状态 (默认: UNSCHEDULED 未调度)
+    State state_ : 8 {Handle::UNSCHEDULED};  // 句柄状态 (默认: UNSCHEDULED 未调度)
 };
 
 // 句柄信息
@@ -48,27 +95,85 @@ struct HandleInfo {
 
 // 协程句柄
 struct CoroHandle : Handle {
-    virtual ~CoroHandle() = default;
+    CoroHandle() noexcept : Handle(CoroutineTag{}) {}
+
+    virtual ~CoroHandle() {
+#if ASYNCIO_ENABLE_LOOP_DEBUG
+        // 被监视的协程已结束: 事件循环不再访问它
+        if (watched_ == this) [[unlikely]] {
+            watched_ = nullptr;
+        }
+        TaskAccounting::Forget(this);
+#endif
+    }
 
     std::string FrameName() const {
+#if ASYNCIO_ENABLE_FRAME_INFO
         const auto& frame_info = GetFrameInfo();
         return fmt::format("{} at {}:{}", frame_info.function_name(), frame_info.file_name(),
                            frame_info.line());
+#else
+        return fmt::format("coroutine at {}", fmt::ptr(this));  // 未保存源码位置
+#endif
     }
 
+    // 恢复协程执行 (非虚函数: 事件循环的热路径直接调用)
+    // NOTE: 运行期间把当前取消令牌, 优先级与上下文切换为本协程的, 使其中创建的子协程继承它们;
+    //       每次恢复执行重置操作预算 (见 detail/budget.hpp)
+    void Resume() {
+#if ASYNCIO_ENABLE_TRACING
+        if (TraceBuffer::IsActive()) [[unlikely]] {
+            return TracedResume();
+        }
+#endif
+        auto prev_token = std::exchange(current_cancel_token_, cancel_token_);
+        auto prev_priority = std::exchange(current_priority_, GetPriority());
+        auto prev_context = Context::Switch(&context_);
+        detail::OperationBudget::Reset();
+        std::coroutine_handle<>::from_address(frame_).resume();
+        Context::Switch(prev_context);
+        current_priority_ = prev_priority;
+        current_cancel_token_ = prev_token;
+    }
+
+    // 虚函数 Run() 的实现与 Resume() 相同 (供只持有 Handle 的调用方使用)
+    void Run() override final { Resume(); }
+
     // 立即调度
     void Schedule();
 
     // 取消调度
     void Cancel();
 
+    // 虚函数: 等待本协程的协程 (co_await 链的上一层, 没有时为 nullptr)
+    virtual CoroHandle const* Continuation() const { return nullptr; }
+
     // TODO: CoroHandle 的 DumpBacktrace() 啥也不做?
     // 纯虚函数: 打印回溯栈
     virtual void DumpBacktrace(size_t depth = 0) const = 0;
 
-private:
-    // 虚函数: 获取帧信息
+public:
+    // 协程观察的取消令牌 (创建时继承自当前正在运行的协程, 可为空)
+    CancellationToken* cancel_token_{current_cancel_token_};
+
+    // 当前正在运行的协程的取消令牌 (由 Resume() 维护)
+    inline static CancellationToken* current_cancel_token_{};
+
+    // 协程的上下文变量 (创建时继承自当前正在运行的协程, 修改时写时复制)
+    Context context_{Context::Current()};
+
+    // 事件循环调试模式下正在运行的协程 (见 watchdog.hpp, 协程结束时清空, 只在事件循环线程中访问)
+    inline static CoroHandle const* watched_{};
+
+    // 虚函数: 获取帧信息 (ASYNCIO_ENABLE_FRAME_INFO 关闭时是本文件的位置)
     virtual const std::source_location& GetFrameInfo() const;
+
+protected:
+    void* frame_{};  // 协程帧地址 (由 promise 的 get_return_object() 设置)
+
+private:
+    // 开启跟踪时的 Resume(): 记录 RESUME/SUSPEND 事件
+    void TracedResume();
 };
 
 }  // namespace asyncio
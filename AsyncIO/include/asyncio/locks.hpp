@@ -0,0 +1,398 @@
+/**
+ *  协程同步原语: AsyncMutex, AsyncSemaphore, AsyncEvent, AsyncCondition, AsyncRWLock.
+ *  - 等待者嵌入在可等待对象中 (侵入式 FIFO 队列), 每次等待不分配内存
+ *  - 释放时把所有权直接移交给队首等待者, 并通过 CallSoon 唤醒, 不会出现"惊群"和插队
+ *  - 挂起期间观察协程的取消令牌: 被取消时离开队列并抛出 CancelledError
+ *  - 不挂起就完成时消耗操作预算, 耗尽时先让出一次事件循环 (见 detail/budget.hpp)
+ *  NOTE: 同步原语必须比所有等待它的协程活得更久
+ */
+
+#pragma once
+
+// std
+#include <coroutine>
+#include <cstddef>
+#include <utility>
+// asyncio
+#include <asyncio/cancellation.hpp>
+#include <asyncio/detail/budget.hpp>
+#include <asyncio/detail/intrusive_list.hpp>
+#include <asyncio/detail/noncopyable.hpp>
+#include <asyncio/event_loop.hpp>
+#include <asyncio/exception.hpp>
+#include <asyncio/handle.hpp>
+#include <asyncio/task.hpp>
+
+namespace asyncio {
+
+namespace detail {
+
+// 同步原语的等待者: 挂起期间停放在同步原语的 FIFO 队列中
+struct SyncWaiter : IntrusiveListNode, NonCopyable {
+    virtual ~SyncWaiter() = default;
+
+    // 挂起协程并登记取消回调, 返回 false 表示令牌已被取消 (不挂起)
+    bool Suspend(CoroHandle& coro);
+
+    // 唤醒等待者 (调用前已从队列中移除), 所有权随之移交
+    void Wakeup();
+
+    // 协程恢复执行: 被取消时抛出 CancelledError
+    void Resume();
+
+    // 令牌被取消: 从队列中移除并唤醒协程
+    virtual void OnCancel();
+
+    // await_ready 的快速路径: 已完成但操作预算耗尽时仍挂起, 由 await_suspend 调用 Reschedule()
+    bool Ready(bool done) {
+        yield_ = done && !OperationBudget::Consume();
+        return done && !yield_;
+    }
+
+    // 操作已完成, 经 CallSoon 让出一次事件循环再返回结果 (所有权随之持有)
+    void Reschedule(CoroHandle& coro);
+
+    // 已获得所有权但协程尚未恢复 (所在协程被销毁时需要归还)
+    bool OwnsPending() const { return granted_ && !resumed_; }
+
+    // 取消回调, 转发给 SyncWaiter::OnCancel
+    struct Canceller : CancellationToken::Callback {
+        explicit Canceller(SyncWaiter& waiter) : waiter_(waiter) {}
+
+        void OnCancel() override final { waiter_.OnCancel(); }
+
+        SyncWaiter& waiter_;
+    };
+
+    CoroHandle* coro_{};          // 挂起的协程
+    Canceller canceller_{*this};  // 登记在取消令牌上的节点
+    bool granted_{false};         // 是否已被唤醒 (获得所有权)
+    bool resumed_{false};         // 协程是否已恢复执行
+    bool cancelled_{false};       // 是否被取消
+    bool yield_{false};           // 快速路径已完成, 因操作预算耗尽而让出
+};
+
+}  // namespace detail
+
+class AsyncMutex;
+
+// 互斥锁的 RAII 守卫, 析构时解锁
+class AsyncLockGuard : NonCopyable {
+public:
+    explicit AsyncLockGuard(AsyncMutex& mutex) : mutex_(&mutex) {}
+
+    AsyncLockGuard(AsyncLockGuard&& other) noexcept : mutex_(std::exchange(other.mutex_, nullptr)) {}
+
+    ~AsyncLockGuard() { Unlock(); }
+
+    // 提前解锁
+    void Unlock();
+
+private:
+    AsyncMutex* mutex_;
+};
+
+// 协程互斥锁 (不可重入)
+class AsyncMutex : NonCopyable {
+    friend class AsyncCondition;
+
+    template <bool Scoped>
+    struct LockAwaiter : detail::SyncWaiter {
+        explicit LockAwaiter(AsyncMutex& mutex) : mutex_(mutex) {}
+
+        ~LockAwaiter() {
+            if (OwnsPending()) {
+                mutex_.Unlock();
+            }
+        }
+
+        bool await_ready() { return Ready(mutex_.TryLock()); }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> caller) {
+            if (yield_) {
+                Reschedule(caller.promise());
+                return true;
+            }
+            if (!Suspend(caller.promise())) {
+                return false;
+            }
+            mutex_.waiters_.PushBack(*this);
+            return true;
+        }
+
+        auto await_resume() {
+            Resume();
+            if constexpr (Scoped) {
+                return AsyncLockGuard{mutex_};
+            }
+        }
+
+        AsyncMutex& mutex_;
+    };
+
+public:
+    // 加锁: co_await mutex.Lock();
+    [[nodiscard]]
+    auto Lock() {
+        return LockAwaiter<false>{*this};
+    }
+
+    // 加锁并返回守卫: auto guard = co_await mutex.ScopedLock();
+    [[nodiscard]]
+    auto ScopedLock() {
+        return LockAwaiter<true>{*this};
+    }
+
+    // 尝试加锁 (有排队者时不插队)
+    bool TryLock();
+
+    // 解锁: 有排队者时直接把锁移交给队首
+    void Unlock();
+
+    bool IsLocked() const { return locked_; }
+
+private:
+    // 锁空闲时直接交给 waiter, 否则排队 (AsyncCondition 唤醒时使用)
+    void Enqueue(detail::SyncWaiter& waiter);
+
+private:
+    bool locked_{false};
+    detail::IntrusiveList<detail::SyncWaiter> waiters_;
+};
+
+// 协程信号量: 限制同时访问共享资源的协程数 (例如数据库连接预算)
+class AsyncSemaphore : NonCopyable {
+    struct AcquireAwaiter : detail::SyncWaiter {
+        explicit AcquireAwaiter(AsyncSemaphore& sem) : sem_(sem) {}
+
+        ~AcquireAwaiter() {
+            if (OwnsPending()) {
+                sem_.Release();
+            }
+        }
+
+        bool await_ready() { return Ready(sem_.TryAcquire()); }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> caller) {
+            if (yield_) {
+                Reschedule(caller.promise());
+                return true;
+            }
+            if (!Suspend(caller.promise())) {
+                return false;
+            }
+            sem_.waiters_.PushBack(*this);
+            return true;
+        }
+
+        void await_resume() { Resume(); }
+
+        AsyncSemaphore& sem_;
+    };
+
+public:
+    explicit AsyncSemaphore(size_t value) : value_(value) {}
+
+    // 获取一个许可: co_await sem.Acquire();
+    [[nodiscard]]
+    auto Acquire() {
+        return AcquireAwaiter{*this};
+    }
+
+    // 尝试获取一个许可 (有排队者时不插队)
+    bool TryAcquire();
+
+    // 归还一个许可: 有排队者时直接移交给队首
+    void Release();
+
+    // 当前可用的许可数
+    size_t Value() const { return value_; }
+
+private:
+    size_t value_;
+    detail::IntrusiveList<detail::SyncWaiter> waiters_;
+};
+
+// 协程事件: Set() 唤醒所有等待者, 之后的等待立即返回, 直到 Clear()
+class AsyncEvent : NonCopyable {
+    struct WaitAwaiter : detail::SyncWaiter {
+        explicit WaitAwaiter(AsyncEvent& event) : event_(event) {}
+
+        bool await_ready() { return Ready(event_.set_); }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> caller) {
+            if (yield_) {
+                Reschedule(caller.promise());
+                return true;
+            }
+            if (!Suspend(caller.promise())) {
+                return false;
+            }
+            event_.waiters_.PushBack(*this);
+            return true;
+        }
+
+        void await_resume() { Resume(); }
+
+        AsyncEvent& event_;
+    };
+
+public:
+    // 等待事件被设置: co_await event.Wait();
+    [[nodiscard]]
+    auto Wait() {
+        return WaitAwaiter{*this};
+    }
+
+    // 设置事件并唤醒所有等待者
+    void Set();
+
+    // 清除事件
+    void Clear() { set_ = false; }
+
+    bool IsSet() const { return set_; }
+
+private:
+    bool set_{false};
+    detail::IntrusiveList<detail::SyncWaiter> waiters_;
+};
+
+// 协程条件变量, 绑定一个 AsyncMutex
+// NOTE: 被通知的等待者直接移入互斥锁的等待队列, 获得锁之后才被唤醒
+class AsyncCondition : NonCopyable {
+    struct WaitAwaiter : detail::SyncWaiter {
+        explicit WaitAwaiter(AsyncCondition& cond) : cond_(cond) {}
+
+        ~WaitAwaiter() {
+            if (OwnsPending()) {
+                cond_.mutex_.Unlock();
+            }
+        }
+
+        constexpr bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> caller) {
+            if (!Suspend(caller.promise())) {
+                return false;  // 已被取消: 不释放锁, 直接抛出 CancelledError
+            }
+            cond_.waiters_.PushBack(*this);
+            cond_.mutex_.Unlock();
+            return true;
+        }
+
+        void await_resume() { Resume(); }
+
+        // 被取消: 离开条件队列, 重新获得锁之后再抛出 CancelledError
+        void OnCancel() override final {
+            Unlink();
+            cancelled_ = true;
+            cond_.mutex_.Enqueue(*this);
+        }
+
+        AsyncCondition& cond_;
+    };
+
+public:
+    explicit AsyncCondition(AsyncMutex& mutex) : mutex_(mutex) {}
+
+    // 释放锁并等待通知, 返回时已重新持有锁 (调用前必须持有锁)
+    [[nodiscard]]
+    auto Wait() {
+        return WaitAwaiter{*this};
+    }
+
+    // 等待直到 pred() 为真 (调用前必须持有锁)
+    template <typename Pred>
+    Task<> Wait(Pred pred) {
+        while (!pred()) {
+            co_await Wait();
+        }
+    }
+
+    // 通知至多 n 个等待者
+    void Notify(size_t n = 1);
+
+    // 通知所有等待者
+    void NotifyAll();
+
+private:
+    AsyncMutex& mutex_;
+    detail::IntrusiveList<detail::SyncWaiter> waiters_;
+};
+
+// 协程读写锁: 多个读者或一个写者, FIFO 公平 (排队中的写者会阻止新的读者插队)
+class AsyncRWLock : NonCopyable {
+    struct LockAwaiter : detail::SyncWaiter {
+        LockAwaiter(AsyncRWLock& lock, bool shared) : lock_(lock), shared_(shared) {}
+
+        ~LockAwaiter() {
+            if (OwnsPending()) {
+                shared_ ? lock_.UnlockShared() : lock_.Unlock();
+            } else if (IsLinked()) {  // 排队中被销毁: 队首变化后可能有等待者可以获得锁
+                Unlink();
+                lock_.Dispatch();
+            }
+        }
+
+        bool await_ready() { return Ready(shared_ ? lock_.TryLockShared() : lock_.TryLock()); }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> caller) {
+            if (yield_) {
+                Reschedule(caller.promise());
+                return true;
+            }
+            if (!Suspend(caller.promise())) {
+                return false;
+            }
+            lock_.waiters_.PushBack(*this);
+            return true;
+        }
+
+        void await_resume() { Resume(); }
+
+        void OnCancel() override final {
+            SyncWaiter::OnCancel();
+            lock_.Dispatch();
+        }
+
+        AsyncRWLock& lock_;
+        bool const shared_;  // 是否为读者
+    };
+
+public:
+    // 加写锁 (独占)
+    [[nodiscard]]
+    auto Lock() {
+        return LockAwaiter{*this, false};
+    }
+
+    // 加读锁 (共享)
+    [[nodiscard]]
+    auto LockShared() {
+        return LockAwaiter{*this, true};
+    }
+
+    bool TryLock();
+
+    bool TryLockShared();
+
+    void Unlock();
+
+    void UnlockShared();
+
+private:
+    // 按 FIFO 顺序唤醒队首可以获得锁的等待者 (一个写者或连续的多个读者)
+    void Dispatch();
+
+private:
+    size_t readers_{0};   // 持有读锁的读者数
+    bool writer_{false};  // 是否有写者持有锁
+    detail::IntrusiveList<LockAwaiter> waiters_;
+};
+
+}  // namespace asyncio
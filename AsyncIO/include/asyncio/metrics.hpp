@@ -0,0 +1,127 @@
+/**
+ *  事件循环指标: 计数器, 瞬时值与 HDR 风格的直方图, 以及 Prometheus 文本格式导出.
+ *  - 编译期开关 ASYNCIO_ENABLE_LOOP_METRICS (detail/config.hpp), 运行期由 EventLoop::EnableMetrics() 开启
+ *  - EventLoop::Metrics() 返回快照, 可由协程定期抓取; EventLoop::ResetMetrics() 开始新的统计区间
+ *  - 用于区分事件循环饱和 (利用率高, 单个回调都很快) 与慢回调 (单个回调耗时的最大值/高分位很大)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace asyncio {
+
+// 对数-线性分桶的直方图 (HDR Histogram 风格): 每个 2 的幂区间再等分为 16 个子桶,
+// 记录 O(1), 分位数的相对误差不超过 1/16; 小于 16 的值精确记录
+// NOTE: 固定大小 (约 6KB), 记录时不分配内存
+class LatencyHistogram {
+    static constexpr uint32_t kSubBucketBits = 4;
+    static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+    static constexpr uint32_t kMaxExponent = 47;  // 超过 2^48 的值记入最后一个桶 (纳秒约 78 小时)
+
+public:
+    static constexpr size_t kBuckets = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+public:
+    // 记录一个值
+    void Record(uint64_t value) {
+        ++counts_[Index(value)];
+        ++count_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    // 记录一个时长 (纳秒)
+    template <typename Rep, typename Period>
+    void Record(std::chrono::duration<Rep, Period> duration) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        Record(static_cast<uint64_t>(std::max<decltype(ns)>(ns, 0)));
+    }
+
+    uint64_t Count() const { return count_; }
+
+    uint64_t Sum() const { return sum_; }
+
+    uint64_t Min() const { return count_ ? min_ : 0; }
+
+    uint64_t Max() const { return max_; }
+
+    double Mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    // 分位数 (percentile: 0 ~ 100), 返回所在桶的上界 (不超过最大值)
+    uint64_t ValueAtPercentile(double percentile) const;
+
+    // 合并另一个直方图
+    void Merge(LatencyHistogram const& other);
+
+    void Reset() { *this = LatencyHistogram{}; }
+
+private:
+    static size_t Index(uint64_t value) {
+        if (value < kSubBuckets) {
+            return value;
+        }
+        uint32_t exponent = std::bit_width(value) - 1;  // 最高位
+        if (exponent > kMaxExponent) {
+            return kBuckets - 1;
+        }
+        uint32_t shift = exponent - kSubBucketBits;
+        return (shift + 1) * kSubBuckets + ((value >> shift) & (kSubBuckets - 1));
+    }
+
+    // 桶内的最大值
+    static uint64_t UpperBound(size_t index);
+
+private:
+    std::array<uint64_t, kBuckets> counts_{};
+    uint64_t count_{0};
+    uint64_t sum_{0};
+    uint64_t min_{std::numeric_limits<uint64_t>::max()};
+    uint64_t max_{0};
+};
+
+// 事件循环指标快照
+struct LoopMetrics {
+    // 计数器 (自开启或上次 ResetMetrics() 起累计)
+    uint64_t iterations{};         // 迭代次数
+    uint64_t callbacks{};          // 执行的回调数 (协程恢复 + Handle::Run())
+    uint64_t io_events{};          // Select 返回的 IO 事件数
+    uint64_t timers_fired{};       // 到期的定时任务数
+    uint64_t cancelled_skipped{};  // 出队或到期时因已取消而跳过的回调数
+    uint64_t busy_poll_hits{};     // 忙轮询窗口内等到事件的次数 (EnableBusyPoll)
+    uint64_t busy_poll_misses{};   // 轮询完整个窗口仍没有事件, 转为阻塞的次数
+    uint64_t time_slices_expired{};  // 因时间片用完而提前结束的迭代次数 (SetTimeSlice)
+
+    // 瞬时值 (快照时刻)
+    size_t ready_size{};         // 就绪队列长度
+    size_t timer_backlog{};      // 定时任务数 (包括已取消尚未清理的)
+    size_t cancelled_backlog{};  // 尚未清理的取消记录数
+
+    // 直方图
+    LatencyHistogram iteration_time;           // 每次迭代除 Select 阻塞以外的耗时 (纳秒)
+    LatencyHistogram select_time;              // 每次 Select 的阻塞时间 (纳秒, 包括忙轮询)
+    LatencyHistogram callback_time;            // 单个回调的耗时 (纳秒), 最大值即最慢的回调
+    LatencyHistogram ready_depth;              // 每次迭代开始执行时就绪队列的长度
+    LatencyHistogram callbacks_per_iteration;  // 每次迭代执行的回调数
+
+    // 利用率: 迭代耗时 / (迭代耗时 + Select 阻塞时间), 接近 1 表示事件循环饱和
+    double Utilization() const {
+        auto busy = static_cast<double>(iteration_time.Sum());
+        auto total = busy + static_cast<double>(select_time.Sum());
+        return total > 0 ? busy / total : 0.0;
+    }
+};
+
+// 以 Prometheus 文本格式 (0.0.4) 导出指标: 计数器/瞬时值为 counter/gauge, 直方图为 summary
+// (分位数 0.5/0.9/0.99/0.999, 时间单位为秒) 并附带 _max
+std::string FormatPrometheus(LoopMetrics const& metrics, std::string_view prefix = "asyncio_loop");
+
+}  // namespace asyncio
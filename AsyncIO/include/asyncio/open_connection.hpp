@@ -1,11 +1,16 @@
 #pragma once
 
+#include <netdb.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 
+#include <chrono>
+#include <system_error>
+
 //
 #include <asyncio/detail/selector/event.hpp>
 #include <asyncio/finally.hpp>
+#include <asyncio/result.hpp>
 #include <asyncio/stream.hpp>
 #include <asyncio/task.hpp>
 
@@ -17,12 +22,37 @@ namespace detail {
 // 1. connect 非阻塞返回 EINPROGRESS
 // 2. epoll_wait 等待 socket 可写
 // 3. getsockopt 检查 connect 是否成功
-Task<bool> Connect(int fd, const sockaddr *addr, socklen_t len) noexcept;
+// 返回空的错误码表示连接成功
+Task<std::error_code> Connect(int fd, const sockaddr *addr, socklen_t len) noexcept;
 
 }  // namespace detail
 
+// 连接选项 (时间为 0 表示不限制)
+struct ConnectOptions {
+    // 启动下一个地址的连接尝试前的等待时间 (RFC 8305 Connection Attempt Delay)
+    std::chrono::milliseconds attempt_delay{250};
+    // 单个地址连接尝试的超时时间
+    std::chrono::milliseconds attempt_timeout{0};
+    // 整体连接超时时间, 超时抛出 std::errc::timed_out
+    std::chrono::milliseconds connect_timeout{0};
+};
+
 // 异步打开一个到指定 ip 地址和端口 port 的 TCP 连接
 // NOTE: 这里可能输入的是域名而不是 ip, 因此需要 getaddrinfo, 且同时支持 ipv4 和 ipv6
-Task<Stream> OpenConnection(std::string_view ip, uint16_t port);
+// Happy Eyeballs (RFC 8305): 按地址族交错排列解析结果, 每隔 attempt_delay (或上一个尝试失败时)
+// 启动下一个地址的连接尝试, 多个尝试并行进行, 第一个成功者胜出, 其余尝试被取消
+Task<Stream> OpenConnection(std::string_view ip, uint16_t port, ConnectOptions options = {});
+
+// 不抛异常版本: 解析失败/全部连接失败返回 std::errc::address_not_available,
+// 整体超时返回 std::errc::timed_out
+Task<Result<Stream>> TryOpenConnection(std::string_view ip, uint16_t port,
+                                       ConnectOptions options = {});
+
+namespace detail {
+
+// 对解析结果 addrs (getaddrinfo 的链表, 需要在返回前保持有效) 执行 Happy Eyeballs 连接
+Task<Result<Stream>> ConnectAddresses(const addrinfo *addrs, ConnectOptions options);
+
+}  // namespace detail
 
 }  // namespace asyncio
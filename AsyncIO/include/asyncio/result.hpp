@@ -1,14 +1,28 @@
 #pragma once
 
+#include <asyncio/detail/void_value.hpp>
 #include <asyncio/exception.hpp>
 #include <optional>
+#include <system_error>
 #include <variant>
 
 namespace asyncio {
 
-// 结果类封装
+// 结果类封装: 值 / 异常 / 错误码
+// NOTE: 错误码用于不抛异常的 I/O 路径 (TryRead 等), 不分配 exception_ptr,
+// 只有调用 GetResult() 时才转换为 std::system_error 抛出
 template <typename T>
 struct Result {
+    Result() = default;
+
+    // 以值构造 (expected 风格的返回值)
+    Result(T value) : result_(std::in_place_index<1>, std::move(value)) {}
+
+    // 以错误码构造 (expected 风格的返回值)
+    Result(std::error_code error) noexcept
+        requires(!std::is_same_v<T, std::error_code>)
+        : result_(std::in_place_index<kError>, error) {}
+
     // 判断 Result 是否有值
     constexpr bool HasValue() const noexcept {
         // nullptr -> 不是 monostate -> 有别的有效值
@@ -18,18 +32,44 @@ struct Result {
     // 设置 Result 值
     template <typename R>  // NOTE: 加了一个模板参数 R, 这样 R 可转为 T
     constexpr void SetValue(R&& value) noexcept {
-        result_.template emplace<T>(std::forward<R>(value));
+        result_.template emplace<1>(std::forward<R>(value));
     }
 
     // 设置 result_ 异常
-    void SetException(std::exception_ptr exception) noexcept { result_ = exception; }
+    void SetException(std::exception_ptr exception) noexcept {
+        result_.template emplace<2>(exception);
+    }
+
+    // 设置错误码
+    void SetError(std::error_code error) noexcept { result_.template emplace<kError>(error); }
+
+    // 是否持有值 (而不是异常/错误码/未设置)
+    constexpr bool IsOk() const noexcept { return result_.index() == 1; }
+
+    constexpr explicit operator bool() const noexcept { return IsOk(); }
+
+    // 错误码 (不是错误码时为空)
+    std::error_code Error() const noexcept {
+        auto error = std::get_if<kError>(&result_);
+        return error ? *error : std::error_code{};
+    }
+
+    // 直接访问值 (调用前需确认 IsOk())
+    constexpr T& operator*() & noexcept { return *std::get_if<1>(&result_); }
+
+    constexpr T&& operator*() && noexcept { return std::move(*std::get_if<1>(&result_)); }
+
+    constexpr T* operator->() noexcept { return std::get_if<1>(&result_); }
 
     // 左值对象调用 GetResult() 会拷贝 result_<T> 的值
     constexpr T GetResult() & {
-        if (auto exception = std::get_if<std::exception_ptr>(&result_)) {
+        if (auto exception = std::get_if<2>(&result_)) {
             std::rethrow_exception(*exception);
         }
-        if (auto res = std::get_if<T>(&result_)) {
+        if (auto error = std::get_if<kError>(&result_)) {
+            throw std::system_error(*error);
+        }
+        if (auto res = std::get_if<1>(&result_)) {
             return *res;  // 拷贝
         }
         throw NoResultError{};
@@ -37,10 +77,13 @@ struct Result {
 
     // 右值对象调用 GetResult() 会移动 result_<T> 的值
     constexpr T GetResult() && {
-        if (auto exception = std::get_if<std::exception_ptr>(&result_)) {
+        if (auto exception = std::get_if<2>(&result_)) {
             std::rethrow_exception(*exception);
         }
-        if (auto res = std::get_if<T>(&result_)) {
+        if (auto error = std::get_if<kError>(&result_)) {
+            throw std::system_error(*error);
+        }
+        if (auto res = std::get_if<1>(&result_)) {
             return std::move(*res);  // 用户用右值对象了, 一定不需要了, 所以直接移动
         }
         throw NoResultError{};
@@ -53,37 +96,67 @@ struct Result {
         return SetValue(std::forward<R>(value));
     }
 
-    void unhandled_exception() noexcept { result_ = std::current_exception(); }
+    void unhandled_exception() noexcept { SetException(std::current_exception()); }
     // ---------------------------------------
 
 private:
-    std::variant<std::monostate, T, std::exception_ptr> result_;  // TODO: variant
+    // NOTE: 错误码按下标访问, T 本身可以是 std::error_code
+    static constexpr size_t kError = 3;
+    std::variant<std::monostate, T, std::exception_ptr, std::error_code> result_;
 };
 
 // 结果类 void 特化
+// NOTE: 单个 variant 存储 完成/异常/错误码, 不为每种情况各占一份空间
 template <>
 struct Result<void> {
-    constexpr bool HasValue() const noexcept { return result_.has_value(); }
+    Result() = default;
+
+    // 以错误码构造 (expected 风格的返回值)
+    Result(std::error_code error) noexcept : result_(error) {}
+
+    // 成功 (expected 风格的返回值)
+    static Result Ok() noexcept {
+        Result result;
+        result.return_void();
+        return result;
+    }
+
+    constexpr bool HasValue() const noexcept { return result_.index() != 0; }
 
     void GetResult() {
-        if (result_.has_value() && *result_ != nullptr) {
-            std::rethrow_exception(*result_);
+        if (auto exception = std::get_if<std::exception_ptr>(&result_)) {
+            std::rethrow_exception(*exception);
+        }
+        if (auto error = std::get_if<std::error_code>(&result_)) {
+            throw std::system_error(*error);
         }
     }
 
     void SetException(std::exception_ptr exception) noexcept { result_ = exception; }
 
+    // 设置错误码
+    void SetError(std::error_code error) noexcept { result_ = error; }
+
+    // 是否成功完成 (而不是异常/错误码/未设置)
+    bool IsOk() const noexcept { return std::holds_alternative<VoidValue>(result_); }
+
+    explicit operator bool() const noexcept { return IsOk(); }
+
+    // 错误码 (不是错误码时为空)
+    std::error_code Error() const noexcept {
+        auto error = std::get_if<std::error_code>(&result_);
+        return error ? *error : std::error_code{};
+    }
+
     // ---------------------------------------
     // NOTE: 给 promise_type 继承用
-    void return_void() noexcept {
-        result_.emplace(nullptr);  // 给了一个 nullptr, 不是异常
-    }
+    void return_void() noexcept { result_ = VoidValue{}; }
 
     void unhandled_exception() noexcept { result_ = std::current_exception(); }
     // ---------------------------------------
 
 private:
-    std::optional<std::exception_ptr> result_;  // TODO: optional
+    std::variant<std::monostate, VoidValue, std::exception_ptr, std::error_code> result_;
 };
 
 }  // namespace asyncio
@@ -2,6 +2,7 @@
 
 #include <asyncio/detail/concepts/future.hpp>
 #include <asyncio/detail/noncopyable.hpp>
+#include <asyncio/handle.hpp>
 
 namespace asyncio {
 
@@ -16,6 +17,15 @@ struct ScheduledTask : NonCopyable {
         }
     }
 
+    // 以指定优先级调度 (任务中创建的协程继承该优先级)
+    template <concepts::Future Fut>
+    ScheduledTask(Fut&& task, Priority priority) : task_(std::forward<Fut>(task)) {
+        if (task_.IsValid() && !task_.IsDone()) {
+            task_.handle_.promise().SetPriority(priority);
+            task_.handle_.promise().Schedule();
+        }
+    }
+
 public:
     decltype(auto) operator co_await() const& noexcept { return task_.operator co_await(); }
 
@@ -44,10 +54,19 @@ private:
 template <concepts::Future Fut>
 ScheduledTask(Fut&&) -> ScheduledTask<Fut>;
 
+template <concepts::Future Fut>
+ScheduledTask(Fut&&, Priority) -> ScheduledTask<Fut>;
+
 template <concepts::Future Fut>
 [[nodiscard("忽略 (分离) 一个任务将不会被调度执行")]]
 ScheduledTask<Fut> schedule_task(Fut&& fut) {
     return ScheduledTask{std::forward<Fut>(fut)};  // 有了推导指引, 这里的 CTAD 才能成功
 }
 
+template <concepts::Future Fut>
+[[nodiscard("忽略 (分离) 一个任务将不会被调度执行")]]
+ScheduledTask<Fut> schedule_task(Fut&& fut, Priority priority) {
+    return ScheduledTask{std::forward<Fut>(fut), priority};
+}
+
 }  // namespace asyncio
@@ -1,28 +1,75 @@
 #pragma once
 
 #include <chrono>
+#include <asyncio/cancellation.hpp>
 #include <asyncio/detail/noncopyable.hpp>
+#include <asyncio/exception.hpp>
 #include <asyncio/task.hpp>
 
 namespace asyncio {
 
 namespace detail {
 
+// 延时等待, 挂起期间观察协程的取消令牌: 令牌被取消时立即唤醒并抛出 CancelledError
 template <typename Duration>
-struct SleepAwaiter : private NonCopyable {
+struct SleepAwaiter : CancellationToken::Callback, private NonCopyable {
     explicit SleepAwaiter(Duration delay) : delay_(delay) {}
 
+    // 所在协程被提前销毁时取消定时器
+    ~SleepAwaiter() {
+        if (timer_.GetState() == Handle::SCHEDULED) {
+            GetEventLoop().CancelHandle(timer_);
+        }
+    }
+
     constexpr bool await_ready() noexcept { return false; }
 
-    constexpr void await_resume() const noexcept {}
+    void await_resume() {
+        Unlink();  // 从取消令牌上注销
+        if (token_ && token_->IsCancelled()) {
+            throw CancelledError{};
+        }
+    }
 
+    // 返回 false 表示不挂起 (令牌已被取消, await_resume 中抛出 CancelledError)
     template <typename Promise>
-    void await_suspend(std::coroutine_handle<Promise> caller) const noexcept {
-        GetEventLoop().CallLater(delay_, caller.promise());
+    bool await_suspend(std::coroutine_handle<Promise> caller) noexcept {
+        token_ = caller.promise().cancel_token_;
+        if (token_ && token_->IsCancelled()) {
+            return false;
+        }
+        timer_.coro_ = &caller.promise();
+        timer_.coro_->SetState(Handle::SUSPEND);
+        GetEventLoop().CallLater(delay_, timer_);
+        if (token_) {
+            token_->Register(*this);
+        }
+        return true;
+    }
+
+    // 令牌被取消: 取消定时器并立即唤醒协程
+    void OnCancel() override final {
+        if (timer_.GetState() == Handle::SCHEDULED) {
+            GetEventLoop().CancelHandle(timer_);
+            GetEventLoop().CallSoon(*timer_.coro_);
+        }
     }
 
 private:
+    // 定时器到期时直接恢复挂起的协程
+    // NOTE: 定时器与协程使用不同的句柄, 取消定时器不会影响随后对协程的调度
+    struct TimerHandle : Handle {
+        void Run() override final {
+            coro_->SetState(Handle::UNSCHEDULED);
+            coro_->Resume();
+        }
+
+        CoroHandle* coro_{};  // 挂起的协程
+    };
+
     Duration delay_;
+    TimerHandle timer_;
+    CancellationToken* token_{};  // 挂起期间观察的取消令牌
 };
 
 template <typename Rep, typename Period>
@@ -4,10 +4,11 @@
 #include <sys/types.h>
 
 #include <asyncio/detail/concepts/awaitable.hpp>
+#include <asyncio/detail/probes.hpp>
 #include <asyncio/finally.hpp>
 #include <asyncio/scheduled_task.hpp>
 #include <asyncio/stream.hpp>
-#include <list>
+#include <asyncio/task_group.hpp>
 
 namespace asyncio {
 
@@ -31,16 +32,23 @@ struct Server : NonCopyable {
 
     ~Server() { Close(); }
 
+    // 连接的处理协程是任务组的子任务: ServeForever 被取消或 accept 出错时取消所有连接, 等它们结束后返回
+    // 单个连接的处理协程抛出的异常只记录到 stderr, 不影响其他连接
     Task<void> ServeForever() {
+        co_await TaskGroup::Scope([this](TaskGroup& connections) { return Accept(connections); });
+    }
+
+private:
+    Task<void> Accept(TaskGroup& connections) {
         Event ev{.fd = listenfd_, .flags = Event::Flags::EVENT_READ};
         auto ev_awaiter = GetEventLoop().WaitEvent(ev);
-        std::list<ScheduledTask<Task<>>> connected;
         while (true) {
             sockaddr_storage remoteaddr{};  // 对端地址信息
             socklen_t addrlen = sizeof(remoteaddr);
             co_await ev_awaiter;
             // 非阻塞式 accept
             int connfd_ = ::accept(listenfd_, reinterpret_cast<sockaddr*>(&remoteaddr), &addrlen);
+            ASYNCIO_PROBE(server_accept, listenfd_, connfd_, connfd_ == -1 ? errno : 0);
             if (connfd_ == -1) {
                 if (errno == EAGAIN || errno == EWOULDBLOCK) {
                     // 继续等待连接
@@ -50,26 +58,22 @@ struct Server : NonCopyable {
                     throw std::system_error(errno, std::system_category());
                 }
             }
-            // 将处理新连接的回调函数 (connect_cb_) 作为协程任务添加到事件循环中
-            connected.emplace_back(schedule_task(connect_cb_(Stream{connfd_, remoteaddr})));
-            CleanUpConnected(connected);
+            // 将处理新连接的回调函数 (connect_cb_) 作为子任务启动 (任务组回收已结束的连接)
+            connections.Spawn(HandleConnection(connect_cb_(Stream{connfd_, remoteaddr})));
         }
     }
 
-private:
-    // 用于垃圾回收，移除已经处理完毕的客户端连接任务。
-    void CleanUpConnected(std::list<ScheduledTask<Task<>>>& connected) {
-        if (connected.size() < 100) [[likely]] {
-            return;
-        }
-        for (auto iter = connected.begin(); iter != connected.end();) {
-            if (iter->IsDone()) {
-                // 即使不关心返回值，也需要调用 GetResult() 来处理可能发生的异常
-                iter->GetResult();
-                iter = connected.erase(iter);
-            } else {
-                ++iter;  // 任务未完成, 继续检查下一个
-            }
+    // 运行一个连接的处理协程: 异常不传播给任务组 (否则会取消其他连接)
+    template <concepts::Awaitable Fut>
+    static Task<void> HandleConnection(Fut handler) {
+        try {
+            co_await std::move(handler);
+        } catch (CancelledError const&) {
+            throw;
+        } catch (std::exception const& e) {
+            fmt::print(stderr, "asyncio: connection handler failed: {}\n", e.what());
+        } catch (...) {
+            fmt::print(stderr, "asyncio: connection handler failed: unknown exception\n");
         }
     }
 
@@ -1,18 +1,27 @@
 #pragma once
 
 #include <fcntl.h>
+#include <limits.h>
 #include <netdb.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <system_error>
 #include <utility>
 #include <vector>
 
 //
 #include <asyncio/detail/noncopyable.hpp>
+#include <asyncio/detail/probes.hpp>
 #include <asyncio/detail/selector/event.hpp>
 #include <asyncio/event_loop.hpp>
+#include <asyncio/generator.hpp>
+#include <asyncio/result.hpp>
 #include <asyncio/task.hpp>
 
 namespace asyncio {
@@ -22,6 +31,11 @@ namespace socket {
 // 设置文件描述符 fd 为阻塞/非阻塞模式
 bool SetBlocking(int fd, bool blocking);
 
+// 设置套接字的 SO_BUSY_POLL: 内核在没有数据时先在网卡接收队列上忙等最多 budget, 而不是等中断
+// (需要网卡驱动支持 NAPI busy poll; epoll_wait 中的忙等还需要 sysctl net.core.busy_poll > 0)
+// NOTE: 超过 sysctl net.core.busy_read 的值需要 CAP_NET_ADMIN, 失败时返回错误码 (EPERM)
+Result<void> SetBusyPoll(int fd, std::chrono::microseconds budget);
+
 }  // namespace socket
 
 // 网络流
@@ -49,7 +63,8 @@ struct Stream : NonCopyable {
           write_event_{std::exchange(other.write_event_, {})},
           read_awaiter_{std::move(other.read_awaiter_)},
           write_awaiter_{std::move(other.write_awaiter_)},
-          sock_info_{other.sock_info_} {}
+          sock_info_{other.sock_info_},
+          write_mode_{other.write_mode_} {}
 
     ~Stream() { Close(); }
 
@@ -67,6 +82,14 @@ public:
         write_fd_ = -1;
     }
 
+    // 注销读写事件 (连接空闲或在协程间移交时调用, 下一次读写时会重新注册)
+    void ReleaseEvents() {
+        read_awaiter_.Destroy();
+        write_awaiter_.Destroy();
+        read_awaiter_.event_.handle_info = {};
+        write_awaiter_.event_.handle_info = {};
+    }
+
     /**
      * @brief 异步读取数据
      *
@@ -75,12 +98,12 @@ public:
      */
     Task<Buffer> Read(ssize_t sz = -1) {
         if (sz < 0) {  // 如果 sz < 0 (默认), 则读取直到 EOF
-            co_return co_await ReadUntilEof();
+            co_return (co_await TryReadUntilEof()).GetResult();
         }
 
         Buffer result(sz, 0);
         co_await read_awaiter_;  // 等待直到可读
-        sz = ::read(read_fd_, result.data(), result.size());
+        sz = ReadSome(result.data(), result.size());
         if (sz == -1) {
             throw std::system_error(errno, std::system_category());
         }
@@ -88,12 +111,63 @@ public:
         co_return result;
     }
 
+    /**
+     * @brief 按块异步读取数据直到 EOF, 每块最多 size 字节 (内存占用与数据总量无关)
+     *
+     * @param size 每块的最大字节数
+     * @return AsyncGenerator<Buffer>
+     */
+    AsyncGenerator<Buffer> Chunks(size_t size = chunk_size) {
+        while (true) {
+            co_await read_awaiter_;
+            Buffer chunk(size, 0);
+            ssize_t sz = ReadSome(chunk.data(), chunk.size());
+            if (sz == -1) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    continue;
+                }
+                throw std::system_error(errno, std::system_category());
+            }
+            if (sz == 0) {  // EOF
+                co_return;
+            }
+            chunk.resize(sz);
+            co_yield std::move(chunk);
+        }
+    }
+
+    /**
+     * @brief 异步读取数据 (不抛异常版本, 读错误以错误码返回)
+     *
+     * @param sz 读取的字节数, 默认 -1 读取到 EOF
+     * @return Task<Result<Buffer>> EOF 时为空 Buffer, 出错时为错误码 (如 ECONNRESET)
+     */
+    Task<Result<Buffer>> TryRead(ssize_t sz = -1) {
+        if (sz < 0) {
+            co_return co_await TryReadUntilEof();
+        }
+
+        Buffer result(sz, 0);
+        co_await read_awaiter_;
+        sz = ReadSome(result.data(), result.size());
+        if (sz == -1) {
+            co_return std::error_code(errno, std::system_category());
+        }
+        result.resize(sz);
+        co_return std::move(result);
+    }
+
     Task<> Write(const Buffer& buf) {
         ssize_t total_write = 0;
+        WriteEventGuard guard{*this};
         while (total_write < static_cast<ssize_t>(buf.size())) {
-            co_await write_awaiter_;
-            ssize_t sz = ::write(write_fd_, buf.data() + total_write, buf.size() - total_write);
+            ssize_t sz = WriteSome(buf.data() + total_write, buf.size() - total_write);
             if (sz == -1) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {  // 发送缓冲区满, 等待可写
+                    guard.waited = true;
+                    co_await write_awaiter_;
+                    continue;
+                }
                 throw std::system_error(errno, std::system_category());
             }
             total_write += sz;
@@ -101,6 +175,30 @@ public:
         co_return;
     }
 
+    /**
+     * @brief 异步写入数据 (不抛异常版本, 写错误以错误码返回)
+     *
+     * @param buf 待写入的数据
+     * @return Task<Result<void>> 出错时为错误码 (如 EPIPE, ECONNRESET)
+     */
+    Task<Result<void>> TryWrite(const Buffer& buf) {
+        ssize_t total_write = 0;
+        WriteEventGuard guard{*this};
+        while (total_write < static_cast<ssize_t>(buf.size())) {
+            ssize_t sz = WriteSome(buf.data() + total_write, buf.size() - total_write);
+            if (sz == -1) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    guard.waited = true;
+                    co_await write_awaiter_;
+                    continue;
+                }
+                co_return std::error_code(errno, std::system_category());
+            }
+            total_write += sz;
+        }
+        co_return Result<void>::Ok();
+    }
+
     /**
      * @brief 获取套接字地址信息
      *
@@ -108,8 +206,81 @@ public:
      */
     sockaddr_storage const& GetSockInfo() const { return sock_info_; }
 
+    // 获取 (读端) 文件描述符
+    int GetFd() const { return read_fd_; }
+
+    // 设置内核的套接字忙轮询 (SO_BUSY_POLL, 见 socket::SetBusyPoll)
+    Result<void> SetBusyPoll(std::chrono::microseconds budget) {
+        return socket::SetBusyPoll(read_fd_, budget);
+    }
+
 private:
-    Task<Buffer> ReadUntilEof() {
+    // 注销写就绪事件: 套接字几乎总是可写, 水平触发的 EPOLLOUT 保持注册会让每次 epoll_wait 立即返回 (空转)
+    void ReleaseWriteEvent() {
+        write_awaiter_.Destroy();
+        write_awaiter_.event_.handle_info = {};
+    }
+
+    // 等待过可写时, 写协程结束 (包括出错, 被取消或被销毁) 时注销写就绪事件
+    struct WriteEventGuard {
+        ~WriteEventGuard() {
+            if (waited) {
+                stream.ReleaseWriteEvent();
+            }
+        }
+
+        Stream& stream;
+        bool waited{false};
+    };
+
+    // 写端 fd 的类型: 默认按套接字写入, 第一次写入返回 ENOTSOCK 时查询一次是否阻塞
+    enum class WriteMode : uint8_t { SOCKET, FILE, BLOCKING_FILE };
+
+    // 读取一次
+    ssize_t ReadSome(char* data, size_t size) {
+        ssize_t sz = ::read(read_fd_, data, size);
+        ASYNCIO_PROBE(stream_read, read_fd_, sz, sz == -1 ? errno : 0);
+        return sz;
+    }
+
+    // 写入一次: 对端已关闭时返回 EPIPE 而不是触发 SIGPIPE (非套接字 fd 退化为 WriteFile)
+    // NOTE: 先直接写 (MSG_DONTWAIT, accept 得到的套接字是阻塞的), 缓冲区满 (EAGAIN) 时才等待可写
+    ssize_t WriteSome(const char* data, size_t size) {
+        ssize_t sz;
+        if (write_mode_ == WriteMode::SOCKET) {
+            sz = ::send(write_fd_, data, size, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (sz == -1 && errno == ENOTSOCK) {
+                write_mode_ = (::fcntl(write_fd_, F_GETFL) & O_NONBLOCK) ? WriteMode::FILE
+                                                                         : WriteMode::BLOCKING_FILE;
+                sz = WriteFile(data, size);
+            }
+        } else {
+            sz = WriteFile(data, size);
+        }
+        ASYNCIO_PROBE(stream_write, write_fd_, sz, sz == -1 ? errno : 0);
+        return sz;
+    }
+
+    // 非套接字 fd (管道, 终端...) 写入一次: write 没有 MSG_DONTWAIT, 阻塞的 fd 先确认可写
+    // (否则返回 EAGAIN 等待可写), 且最多写 PIPE_BUF 字节 (可写时保证不阻塞), 避免阻塞事件循环
+    ssize_t WriteFile(const char* data, size_t size) {
+        if (write_mode_ == WriteMode::BLOCKING_FILE) {
+            pollfd pfd{};
+            pfd.fd = write_fd_;
+            pfd.events = POLLOUT;
+            int ready = ::poll(&pfd, 1, 0);
+            if (ready <= 0) {
+                if (ready == 0) {
+                    errno = EAGAIN;
+                }
+                return -1;
+            }
+            size = std::min<size_t>(size, PIPE_BUF);
+        }
+        return ::write(write_fd_, data, size);
+    }
+
+    Task<Result<Buffer>> TryReadUntilEof() {
         Buffer result(chunk_size, 0);
 
         int current_read = 0;
@@ -121,20 +292,20 @@ private:
             if (result.size() < total_read + chunk_size) {
                 result.resize(total_read + chunk_size);  // 确保读之前有足够空间
             }
-            current_read = ::read(read_fd_, result.data() + total_read, chunk_size);
+            current_read = ReadSome(result.data() + total_read, chunk_size);
             if (current_read == -1) {
                 // 非阻塞 IO 是否因为当前资源暂时不可用而失败
                 if (errno == EAGAIN || errno == EWOULDBLOCK) {
                     current_read = 1;  // > 0 保持循环继续进行
                     continue;
                 }
-                throw std::system_error(errno, std::system_category());
+                co_return std::error_code(errno, std::system_category());
             }
             total_read += current_read;
         } while (current_read > 0);  // 当 current_read == 0 时, EOF 结束循环
 
         result.resize(total_read);  // 修剪大小
-        co_return result;
+        co_return std::move(result);
     }
 
 private:
@@ -150,6 +321,7 @@ private:
     EventLoop::WaitEventAwaiter write_awaiter_{GetEventLoop().WaitEvent(write_event_)};
 
     sockaddr_storage sock_info_{};              // 通用套接字地址结构, 兼容 IPv4&6
+    WriteMode write_mode_{WriteMode::SOCKET};   // 写端 fd 的类型 (见 WriteSome)
     constexpr static size_t chunk_size = 4096;  // 每次读操作的块大小 (缓冲区大小) 4KB
 };
 
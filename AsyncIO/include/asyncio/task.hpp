@@ -4,10 +4,14 @@
 
 #include <cassert>
 #include <coroutine>
+#include <cstddef>
+#include <memory>
 #include <source_location>
+#include <type_traits>
 #include <utility>
 //
 #include <asyncio/detail/concepts/promise.hpp>
+#include <asyncio/detail/frame_allocator.hpp>
 #include <asyncio/event_loop.hpp>
 #include <asyncio/handle.hpp>
 #include <asyncio/result.hpp>
@@ -21,17 +25,27 @@ inline constexpr NoWaitAtInitialSuspend no_wait_at_initial_suspend;
 template <typename R>
 struct Task;
 
+namespace detail {
+template <typename R>
+class TaskHandle;
+}  // namespace detail
+
 // PromiseType 继承自 CoroHandle 和 Result
 // - 具有 CoroHandle 的一些方法 (Schedule)
 // - 具有 Result 的一些方法 (return_value/void)
+// NOTE: 参数以 std::allocator_arg_t, Alloc 开头的协程改用 detail::AllocatorPromise (见文件末尾)
 template <typename R = void>
 struct PromiseType : CoroHandle, Result<R> {
     using coro_handle = std::coroutine_handle<PromiseType>;
 
 public:
     // 构造函数
-    // NOTE: 捕获 source location
+    // NOTE: 捕获 source location (ASYNCIO_ENABLE_FRAME_INFO 关闭时不保存)
+#if ASYNCIO_ENABLE_FRAME_INFO
     PromiseType(std::source_location loc = std::source_location::current()) : frame_info_(loc) {}
+#else
+    PromiseType() = default;
+#endif
 
     // 构造函数 (参数: 不挂起)
     template <typename... Args>  // from free function
@@ -43,7 +57,7 @@ public:
 
 public:
     // --------- 协程 promise_type 要求 ----------
-    auto get_return_object() noexcept { return Task<R>{coro_handle::from_promise(*this)}; }
+    auto get_return_object() noexcept { return MakeTask(coro_handle::from_promise(*this)); }
 
     // 协程刚开始执行时是否挂起
     auto initial_suspend() noexcept {
@@ -68,6 +82,7 @@ public:
         // NOTE: 所以 Hello() 能返回到 HelloWorld()
         template <typename Promise>
         constexpr void await_suspend(std::coroutine_handle<Promise> h) const noexcept {
+            TraceBuffer::Emit(TraceEventType::FINAL_SUSPEND, h.promise().GetHandleId());
             // 当前协程执行完毕, 如果存在等待的协程 cont, 则获取事件循环并调用 CallSoon()
             // 将等待协程的句柄 *cont 添加到事件循环的待执行队列 ready_ 中
             // 以便在事件循环的下一次迭代中通过调用句柄的 Run() 恢复 resume 该等待协程的执行
@@ -82,11 +97,13 @@ public:
     auto final_suspend() noexcept { return FinalAwaiter{}; }
 
 public:
-    // 重载基类 Handle 的 Run() 方法: 恢复协程执行
-    void Run() override final { coro_handle::from_promise(*this).resume(); }
-
+#if ASYNCIO_ENABLE_FRAME_INFO
     // 重载基类 CoroHandle 的 GetFrameInfo() 方法: 获取帧信息
     std::source_location const& GetFrameInfo() const override final { return frame_info_; }
+#endif
+
+    // 重载基类 CoroHandle 的 Continuation() 方法: 等待本协程的协程
+    CoroHandle const* Continuation() const override final { return continuation_; }
 
     // 重载基类 CoroHandle 的 DumpBacktrace() 方法: 打印栈回溯
     void DumpBacktrace(size_t depth = 0) const override final {
@@ -98,27 +115,89 @@ public:
         }
     }
 
+    // 协程帧的类型擦除句柄
+    std::coroutine_handle<> GetCoroutine() const noexcept {
+        return std::coroutine_handle<>::from_address(frame_);
+    }
+
+protected:
+    // 由协程帧的句柄创建 Task
+    // NOTE: 派生的 promise (detail::AllocatorPromise) 必须以自己的类型构造句柄
+    //       (coroutine_handle<PromiseType>::from_promise 不能用于基类子对象)
+    auto MakeTask(std::coroutine_handle<> handle) noexcept {
+        frame_ = handle.address();
+#if ASYNCIO_ENABLE_FRAME_INFO
+        TraceBuffer::Emit(TraceEventType::CREATE, GetHandleId(), frame_info_);
+#else
+        TraceBuffer::Emit(TraceEventType::CREATE, GetHandleId());
+#endif
+        return Task<R>{detail::TaskHandle<R>{*this}};
+    }
+
 public:
-    bool const wait_at_initial_suspend_{true};  // 协程体刚开始时是否挂起(默认 true)
-    CoroHandle* continuation_{};       // TODO: 前一个协程句柄(在等待当前协程完成), 如何构造?
+    CoroHandle* continuation_{};  // TODO: 前一个协程句柄(在等待当前协程完成), 如何构造?
+#if ASYNCIO_ENABLE_FRAME_INFO
     std::source_location frame_info_;  // 帧信息 TODO: 给调用?
+#endif
+    bool const wait_at_initial_suspend_{true};  // 协程体刚开始时是否挂起(默认 true)
+};
+
+namespace detail {
+
+// Task 持有的协程句柄: 只保存 promise 指针, 协程帧的句柄由 promise 中保存的帧地址得到
+// NOTE: 协程的 promise 可能是 PromiseType<R> 的派生类 (AllocatorPromise),
+//       不能用 coroutine_handle<PromiseType<R>> 表示
+template <typename R>
+class TaskHandle {
+public:
+    TaskHandle() noexcept = default;
+
+    TaskHandle(std::nullptr_t) noexcept {}
+
+    explicit TaskHandle(PromiseType<R>& promise) noexcept : promise_(&promise) {}
+
+    PromiseType<R>& promise() const noexcept { return *promise_; }
+
+    bool done() const noexcept { return promise_->GetCoroutine().done(); }
+
+    void destroy() const noexcept { promise_->GetCoroutine().destroy(); }
+
+    explicit operator bool() const noexcept { return promise_ != nullptr; }
+
+    bool operator==(TaskHandle const&) const = default;
+
+private:
+    PromiseType<R>* promise_{};
 };
 
+}  // namespace detail
+
 template <typename R = void>
 struct Task : NonCopyable {
     using promise_type = PromiseType<R>;
-    using coro_handle = std::coroutine_handle<promise_type>;
+    using coro_handle = detail::TaskHandle<R>;
 
     // 友元类
     template <concepts::Future>
     friend struct ScheduledTask;
 
+    friend class TaskGroup;
+
 public:
     explicit Task(coro_handle h) noexcept : handle_(h) {}
 
     // 移动构造函数: 移动协程句柄
     Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
 
+    // 移动赋值: 先销毁当前持有的任务
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            Destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
     ~Task() { Destroy(); }
 
 public:
@@ -208,4 +287,41 @@ private:
 static_assert(concepts::Promise<Task<>::promise_type>);
 static_assert(concepts::Future<Task<>>);
 
+#if ASYNCIO_ENABLE_FRAME_ALLOCATOR
+namespace detail {
+
+// 从 Alloc 分配协程帧的 promise, 增加类作用域的 operator new/delete
+template <typename R, typename Alloc>
+struct AllocatorPromise : PromiseType<R>, FrameAllocator<Alloc> {
+    using PromiseType<R>::PromiseType;
+
+    // 以协程帧实际的 promise 类型构造句柄
+    auto get_return_object() noexcept {
+        return this->MakeTask(std::coroutine_handle<AllocatorPromise>::from_promise(*this));
+    }
+
+#if ASYNCIO_ENABLE_FRAME_INFO
+    // 默认实参在协程处求值, 记录协程的 source location
+    AllocatorPromise(std::source_location loc = std::source_location::current())
+        : PromiseType<R>(loc) {}
+#endif
+};
+
+}  // namespace detail
+#endif
+
 }  // namespace asyncio
+
+#if ASYNCIO_ENABLE_FRAME_ALLOCATOR
+// 参数以 (std::allocator_arg_t, Alloc) 开头的协程从 Alloc 分配帧, 其余协程仍使用全局 operator new
+template <typename R, typename Alloc, typename... Args>  // from free function
+struct std::coroutine_traits<asyncio::Task<R>, std::allocator_arg_t, Alloc, Args...> {
+    using promise_type = asyncio::detail::AllocatorPromise<R, std::remove_cvref_t<Alloc>>;
+};
+
+template <typename R, typename Obj, typename Alloc, typename... Args>  // from member function
+    requires(!std::is_same_v<std::remove_cvref_t<Obj>, std::allocator_arg_t>)
+struct std::coroutine_traits<asyncio::Task<R>, Obj, std::allocator_arg_t, Alloc, Args...> {
+    using promise_type = asyncio::detail::AllocatorPromise<R, std::remove_cvref_t<Alloc>>;
+};
+#endif
@@ -0,0 +1,115 @@
+/**
+ *  任务 CPU 时间统计: 把事件循环中每个回调的运行时间归到一个标签下, 找出占用事件循环 CPU 的请求类型.
+ *  - 标签由 SetTaskLabel() 设置, 与 ContextVar 一样沿协程创建关系传递 (包括嵌套 co_await 的子协程)
+ *  - 未设置标签时归到顶层任务: 沿 co_await 链 (Continuation()) 向上找到的最外层协程的函数名
+ *  - 每个标签统计: 唤醒次数, 运行时间, 单次最长运行时间, 挂起时间 (同一协程两次运行之间)
+ *  - 由 EventLoop::EnableTaskAccounting() 开启, 编译期开关 ASYNCIO_ENABLE_LOOP_DEBUG (detail/config.hpp)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+//
+#include <asyncio/detail/noncopyable.hpp>
+
+namespace asyncio {
+
+struct CoroHandle;
+
+// 设置当前协程 (及此后由它创建的协程) 的统计标签, 例如请求的路由 "GET /users"
+// NOTE: 从下次恢复运行起生效; 标签名只保存一次 (不回收), 应使用数量有限的名字
+void SetTaskLabel(std::string_view label);
+
+// 一个标签的统计
+struct TaskStats {
+    std::string label;
+    uint64_t wakeups{};                        // 被恢复运行的次数
+    std::chrono::nanoseconds cpu_time{};       // 运行时间合计
+    std::chrono::nanoseconds max_run{};        // 单次最长运行时间
+    std::chrono::nanoseconds suspended_time{};  // 挂起时间合计 (同一协程两次运行之间)
+};
+
+// 排序依据
+enum class TaskStatsOrder : uint8_t {
+    CPU_TIME,
+    WAKEUPS,
+    MAX_RUN,
+    SUSPENDED_TIME,
+};
+
+// 任务统计 (事件循环持有, 开启时成为当前活动的统计)
+class TaskAccounting : NonCopyable {
+public:
+    // 非协程回调 (定时器等 Handle) 的标签
+    static constexpr std::string_view kCallbacksLabel = "(callbacks)";
+    // 未设置标签且没有源码位置 (ASYNCIO_ENABLE_FRAME_INFO 关闭) 的协程的标签
+    static constexpr std::string_view kUnlabeled = "(unlabeled)";
+
+    TaskAccounting() = default;
+
+    ~TaskAccounting() { Deactivate(); }
+
+public:
+    // 以下由事件循环调用
+
+    // 开始运行回调 (coroutine 为空表示非协程回调), 返回归属的标签
+    uint32_t BeginRun(CoroHandle const* coroutine, std::chrono::steady_clock::time_point now);
+
+    // 回调运行结束 (alive: 回调结束后仍存活的协程, 记录挂起的起点)
+    void EndRun(uint32_t label, CoroHandle const* alive, std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end);
+
+    // 协程销毁 (由 ~CoroHandle() 调用)
+    static void Forget(CoroHandle const* coroutine) {
+        if (active_) [[unlikely]] {
+            active_->suspended_since_.erase(coroutine);
+        }
+    }
+
+    void Activate() { active_ = this; }
+
+    void Deactivate() {
+        if (active_ == this) {
+            active_ = nullptr;
+        }
+        suspended_since_.clear();  // 停止跟踪协程的销毁, 记录的指针不再可靠
+    }
+
+public:
+    // 所有被运行过的标签的统计
+    std::vector<TaskStats> Stats() const;
+
+    // 按 order 降序的前 n 个标签
+    std::vector<TaskStats> Top(size_t n, TaskStatsOrder order = TaskStatsOrder::CPU_TIME) const;
+
+    // 清空统计, 开始新的统计区间
+    void Reset();
+
+    // 标签名对应的编号 (全局, 首次使用时分配)
+    static uint32_t InternLabel(std::string_view label);
+
+private:
+    // 查找回调归属的标签
+    uint32_t Resolve(CoroHandle const* coroutine);
+
+    struct Counters {
+        uint64_t wakeups{};
+        int64_t cpu_time{};  // 纳秒
+        int64_t max_run{};
+        int64_t suspended_time{};
+    };
+
+    std::vector<Counters> counters_;  // 按标签编号
+    std::unordered_map<CoroHandle const*, std::chrono::steady_clock::time_point>
+        suspended_since_;  // 挂起中的协程上次运行结束的时间
+    std::unordered_map<char const*, uint32_t> root_labels_;  // 顶层任务函数名 -> 标签编号
+
+    inline static TaskAccounting* active_{};
+};
+
+}  // namespace asyncio
@@ -0,0 +1,143 @@
+/**
+ *  结构化并发: 任务组 TaskGroup (nursery).
+ *  - Spawn() 启动子任务, Wait() 等待所有子任务结束
+ *  - 第一个抛出异常的子任务会取消其余子任务, 该异常由 Wait() 重新抛出
+ *  - 取消通过取消令牌传递: 子任务中挂起的 Sleep/IO 等待立即被唤醒并抛出 CancelledError,
+ *    一次 Cancel() 即可在 O(子任务数) 内拆除整棵子树 (嵌套的任务组会级联取消)
+ *  - TaskGroup::Scope(body): body 结束 (正常返回或抛出异常) 时等待所有子任务结束,
+ *    body 抛出异常时先取消子任务, 子任务收尾之后再重新抛出
+ *  NOTE: 析构函数不能挂起: 未等待 Wait() 完成就析构时 (例如所在协程被销毁), 仍在运行的子任务被直接销毁,
+ *        局部对象照常析构, 但 catch 中的清理不会执行. 需要子任务收尾时使用 Scope() 或显式 Wait()
+ */
+
+#pragma once
+
+// std
+#include <exception>
+#include <vector>
+// asyncio
+#include <asyncio/cancellation.hpp>
+#include <asyncio/detail/noncopyable.hpp>
+#include <asyncio/exception.hpp>
+#include <asyncio/task.hpp>
+
+namespace asyncio {
+
+class TaskGroup : NonCopyable {
+public:
+    // 取消令牌挂在创建者 (当前正在运行的协程) 的令牌之下: 外层被取消时整个任务组随之取消
+    TaskGroup()
+        : parent_token_(CoroHandle::current_cancel_token_), token_(CoroHandle::current_cancel_token_) {}
+
+    // NOTE: 未等待 Wait() 完成就析构时, 仍在运行的子任务被直接销毁 (见文件头)
+    ~TaskGroup() = default;
+
+public:
+    // 在任务组的作用域中运行 body(group), 离开作用域时等待所有子任务结束:
+    // co_await TaskGroup::Scope([&](TaskGroup& group) -> Task<> { group.Spawn(...); co_return; });
+    // body 抛出异常时取消子任务, 子任务结束后重新抛出 body 的异常; 否则同 Wait()
+    template <typename Body>
+    static Task<> Scope(Body body) {
+        TaskGroup group;
+        std::exception_ptr exception;
+        try {
+            co_await body(group);
+        } catch (...) {
+            exception = std::current_exception();
+            group.Cancel();
+        }
+        if (!exception) {
+            co_await group.Wait();
+            co_return;
+        }
+        try {
+            co_await group.Wait();
+        } catch (...) {  // body 的异常优先
+        }
+        std::rethrow_exception(exception);
+    }
+
+public:
+    // 启动子任务, 子任务 (及其创建的协程) 观察任务组的取消令牌
+    // priority: 子任务的调度优先级, 默认继承当前正在运行的协程
+    template <typename R>
+    void Spawn(Task<R> task, Priority priority = Handle::current_priority_) {
+        if (!task.IsValid()) {
+            throw InvalidFuture{};
+        }
+        task.handle_.promise().cancel_token_ = &token_;
+        task.handle_.promise().SetPriority(priority);
+        auto child = RunChild(std::move(task));
+        child.handle_.promise().cancel_token_ = &token_;
+        child.handle_.promise().SetPriority(priority);
+        child.handle_.promise().Schedule();
+        ++running_;
+        // 已结束的子任务超过一半时才回收, 均摊 O(1)
+        if (finished_ > children_.size() / 2) {
+            Compact();
+        }
+        children_.push_back(std::move(child));
+    }
+
+    // 等待所有子任务结束
+    // 有子任务抛出异常时重新抛出第一个异常; 外层被取消时抛出 CancelledError
+    [[nodiscard]]
+    Task<> Wait();
+
+    // 取消所有子任务 (Wait() 正常返回)
+    void Cancel() { token_.Cancel(); }
+
+    // 是否已被取消
+    bool IsCancelled() const { return token_.IsCancelled(); }
+
+    // 仍在运行的子任务数
+    size_t Size() const { return running_; }
+
+private:
+    // 运行子任务并收集结果, 子任务的取消不视为错误
+    template <typename R>
+    Task<> RunChild(Task<R> task) {
+        try {
+            co_await std::move(task);
+        } catch (CancelledError const&) {
+        } catch (...) {
+            if (!exception_) {
+                exception_ = std::current_exception();
+                Cancel();  // 第一个异常: 取消其余子任务
+            }
+        }
+        OnChildDone();
+    }
+
+    // 子任务结束, 最后一个子任务结束时唤醒 Wait()
+    void OnChildDone();
+
+    // 回收已结束的子任务
+    void Compact();
+
+    // 等待所有子任务结束的可等待对象
+    struct WaitAwaiter {
+        bool await_ready() const noexcept { return group_.running_ == 0; }
+
+        template <typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> caller) noexcept {
+            caller.promise().SetState(Handle::SUSPEND);
+            group_.waiter_ = &caller.promise();
+        }
+
+        constexpr void await_resume() const noexcept {}
+
+        TaskGroup& group_;
+    };
+
+private:
+    CancellationToken* parent_token_;  // 创建者的取消令牌 (可为空)
+    CancellationToken token_;          // 任务组的取消令牌
+    std::vector<Task<>> children_;     // 子任务 (含已结束但尚未回收的)
+    size_t running_{0};                // 仍在运行的子任务数
+    size_t finished_{0};               // 已结束但尚未回收的子任务数
+    std::exception_ptr exception_;     // 第一个子任务异常
+    CoroHandle* waiter_{};             // 等待所有子任务结束的协程
+};
+
+}  // namespace asyncio
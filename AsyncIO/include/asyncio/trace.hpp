@@ -0,0 +1,111 @@
+/**
+ *  协程生命周期跟踪: 把协程创建, 调度, 恢复/挂起, 结束, IO 等待与定时器到期记录到事件循环的环形缓冲区,
+ *  导出为 Chrome trace JSON (chrome://tracing 或 ui.perfetto.dev 打开).
+ *  - 编译期开关 ASYNCIO_ENABLE_TRACING (detail/config.hpp), 运行期由 EventLoop::EnableTracing() 开启
+ *  - 每个事件 32 字节, 记录不分配内存; 缓冲区满后覆盖最旧的事件
+ *  - 切片名为协程的源码位置 (ASYNCIO_ENABLE_FRAME_INFO 关闭时为 "coroutine #id")
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <vector>
+//
+#include <asyncio/detail/config.hpp>
+#include <asyncio/detail/noncopyable.hpp>
+
+namespace asyncio {
+
+// 跟踪事件类型
+enum class TraceEventType : uint8_t {
+    CREATE,         // 协程创建 (promise 构造)
+    SCHEDULE,       // 加入就绪队列
+    RESUME,         // 开始运行
+    SUSPEND,        // 运行结束 (挂起或完成)
+    FINAL_SUSPEND,  // 协程体执行完毕
+    IO_WAIT,        // 挂起等待 IO 事件
+    TIMER,          // 定时任务到期
+};
+
+// 跟踪事件
+struct TraceEvent {
+    int64_t time;                  // steady_clock 时间 (纳秒)
+    uint64_t id;                   // 句柄 ID
+    std::source_location location;  // 协程源码位置 (CREATE/RESUME, 指向静态存储, 可长期保存)
+    TraceEventType type;
+};
+
+// 跟踪事件的环形缓冲区 (事件循环持有, 开启时成为当前活动的缓冲区)
+class TraceBuffer : NonCopyable {
+public:
+    // capacity: 最多保留的事件数 (向上取整为 2 的幂)
+    explicit TraceBuffer(size_t capacity);
+
+public:
+    // 向当前活动的缓冲区记录事件 (未开启跟踪时只有一次判断)
+    static void Emit(TraceEventType type, uint64_t id, std::source_location location = {}) {
+#if ASYNCIO_ENABLE_TRACING
+        if (active_) [[unlikely]] {
+            active_->Push(type, id, location);
+        }
+#endif
+    }
+
+    // 是否有活动的缓冲区
+    static bool IsActive() { return active_ != nullptr; }
+
+    // 设为/取消当前活动的缓冲区
+    void Activate() { active_ = this; }
+
+    void Deactivate() {
+        if (active_ == this) {
+            active_ = nullptr;
+        }
+    }
+
+    // 当前保留的事件数
+    size_t Size() const { return std::min<uint64_t>(written_, events_.size()); }
+
+    // 被覆盖的事件数
+    uint64_t Dropped() const { return written_ - Size(); }
+
+    // 按时间顺序 (从旧到新) 遍历保留的事件
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (uint64_t i = written_ - Size(); i < written_; ++i) {
+            fn(events_[i & mask_]);
+        }
+    }
+
+    void Clear() { written_ = 0; }
+
+    // 导出为 Chrome trace JSON:
+    // - 每次运行 (RESUME -> SUSPEND) 是事件循环线程上的一个切片
+    // - 每个协程从创建到结束是一个异步切片 (单独一行), 包括挂起的时间
+    // - 调度, IO 等待与定时器到期是瞬时事件
+    std::string ToChromeJson() const;
+
+private:
+    void Push(TraceEventType type, uint64_t id, std::source_location location) {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        events_[written_++ & mask_] = {
+            .time = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count(),
+            .id = id,
+            .location = location,
+            .type = type,
+        };
+    }
+
+private:
+    std::vector<TraceEvent> events_;
+    uint64_t mask_;
+    uint64_t written_{0};  // 累计写入的事件数
+
+    inline static TraceBuffer* active_{};
+};
+
+}  // namespace asyncio
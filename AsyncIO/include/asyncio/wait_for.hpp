@@ -2,6 +2,7 @@
 
 // std
 #include <chrono>
+#include <system_error>
 // asyncio
 #include <asyncio/detail/noncopyable.hpp>
 #include <asyncio/event_loop.hpp>
@@ -14,7 +15,8 @@ namespace asyncio {
 
 namespace detail {
 
-template <typename R, typename Duration>
+// NoThrow: 超时以错误码 std::errc::timed_out 返回 (co_await 得到 Result<R>), 而不是抛出 TimeoutError
+template <typename R, typename Duration, bool NoThrow = false>
 struct WaitForAwaiter : NonCopyable {
     // TODO: concepts::Awaitable
     // 构造函数
@@ -36,7 +38,11 @@ struct WaitForAwaiter : NonCopyable {
 
     // co_await expr 表达式的结果
     constexpr decltype(auto) await_resume() {
-        return std::move(result_).GetResult();  // move 转右值, GetResult() 调用移动
+        if constexpr (NoThrow) {
+            return Result<R>{std::move(result_)};
+        } else {
+            return std::move(result_).GetResult();  // move 转右值, GetResult() 调用移动
+        }
     }
 
 private:
@@ -46,6 +52,7 @@ private:
         try {
             if constexpr (std::is_void_v<R>) {  // void 类型: 仅等待任务完成
                 co_await std::forward<Fut>(fut);
+                result_.return_void();
             } else {  // 非 void 类型: 等待任务完成并捕获返回值
                 result_.SetValue(co_await std::forward<Fut>(fut));
             }
@@ -69,10 +76,21 @@ private:
             GetEventLoop().CallLater(timeout, *this);  // 等待 timeout 时间后执行下面的 Run()
         }
 
+        // WaitFor 被提前销毁 (例如所在任务被取消) 时, 从定时任务中取消自己, 避免悬空回调
+        ~TimeoutHandle() {
+            if (state_ == Handle::SCHEDULED) {
+                GetEventLoop().CancelHandle(*this);
+            }
+        }
+
         void Run() override final {  // timeout!
             // 由于此操作超时, 因此 1. 取消任务并设置异常为超时错误 2. 立即调度等待此操作的协程
             awaiter_.wait_for_task_.Cancel();
-            awaiter_.result_.SetException(std::make_exception_ptr(TimeoutError{}));
+            if constexpr (NoThrow) {
+                awaiter_.result_.SetError(std::make_error_code(std::errc::timed_out));
+            } else {
+                awaiter_.result_.SetException(std::make_exception_ptr(TimeoutError{}));
+            }
             GetEventLoop().CallSoon(*awaiter_.continuation_);
         }
 
@@ -90,14 +108,15 @@ WaitForAwaiter(Fut&&, Duration)
 
 // TODO: 没看懂为什么要延长以及怎么延长的
 // WaitForAwaiterRegistry 存储并管理可等待对象的生命周期
-template <concepts::Awaitable Fut, typename Duration>
+template <concepts::Awaitable Fut, typename Duration, bool NoThrow = false>
 struct WaitForAwaiterRegistry {
     // 构造函数保存可等待对象和超时时间
     WaitForAwaiterRegistry(Fut&& fut, Duration duration)
         : fut_(std::forward<Fut>(fut)), duration_(duration) {}
 
     auto operator co_await() && {
-        return WaitForAwaiter{std::forward<Fut>(fut_), duration_};  // CTAD
+        return WaitForAwaiter<AwaitResult<Fut>, Duration, NoThrow>{std::forward<Fut>(fut_),
+                                                                    duration_};
     }
 
 private:
@@ -116,6 +135,13 @@ Task<AwaitResult<Fut>> WaitFor(NoWaitAtInitialSuspend, Fut&& fut,
     co_return (co_await WaitForAwaiterRegistry{std::forward<Fut>(fut), timeout});  // CTAD
 }
 
+template <concepts::Awaitable Fut, typename Rep, typename Period>
+Task<Result<AwaitResult<Fut>>> TryWaitFor(NoWaitAtInitialSuspend, Fut&& fut,
+                                          std::chrono::duration<Rep, Period> timeout) {
+    co_return (co_await WaitForAwaiterRegistry<Fut, std::chrono::duration<Rep, Period>, true>{
+        std::forward<Fut>(fut), timeout});
+}
+
 }  // namespace detail
 
 // 等待一个异步操作, 但仅等待到指定的时间限制
@@ -125,4 +151,12 @@ Task<AwaitResult<Fut>> WaitFor(Fut&& fut, std::chrono::duration<Rep, Period> tim
     return detail::WaitFor(no_wait_at_initial_suspend, std::forward<Fut>(fut), timeout);
 }
 
+// 不抛异常版本: 超时返回错误码 std::errc::timed_out (不分配异常对象)
+// NOTE: 被等待的操作自身抛出的异常仍保存在 Result 中, 调用 GetResult() 时重新抛出
+template <concepts::Awaitable Fut, typename Rep, typename Period>
+[[nodiscard("忽略 TryWaitFor 函数的返回值是说不通的")]]
+Task<Result<AwaitResult<Fut>>> TryWaitFor(Fut&& fut, std::chrono::duration<Rep, Period> timeout) {
+    return detail::TryWaitFor(no_wait_at_initial_suspend, std::forward<Fut>(fut), timeout);
+}
+
 }  // namespace asyncio
@@ -0,0 +1,109 @@
+/**
+ *  事件循环调试: 慢回调检测与卡顿看门狗.
+ *  协程中的一次阻塞调用 (std::this_thread::sleep_for, 同步 getaddrinfo ...) 会冻结事件循环上的所有连接:
+ *  - 慢回调检测: 事件循环计时每个回调, 超过阈值时报告 (EventLoop::EnableSlowCallbackCheck)
+ *  - 看门狗: 后台线程检测事件循环的一次迭代超过时限仍未完成, 报告卡在哪个回调 (EventLoop::EnableWatchdog)
+ *  - 编译期开关 ASYNCIO_ENABLE_LOOP_DEBUG (detail/config.hpp), 未开启时每次迭代只多一次分支判断
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <source_location>
+#include <thread>
+#include <vector>
+//
+#include <asyncio/detail/noncopyable.hpp>
+#include <asyncio/handle.hpp>
+
+namespace asyncio {
+
+// 慢回调报告 (在事件循环线程中, 回调结束后报告)
+struct SlowCallback {
+    HandleId id;                        // 句柄 ID
+    std::chrono::nanoseconds duration;  // 回调耗时
+    std::source_location location;      // 协程的源码位置 (非协程句柄或未保存源码位置时为空)
+    // 回调结束后仍存活的协程 (可 DumpBacktrace, 包括停在 final_suspend 的协程), 已销毁时为 nullptr
+    CoroHandle const* coroutine;
+};
+
+// 事件循环卡顿报告 (在看门狗线程中, 事件循环仍卡住时报告)
+// NOTE: 只包含事件循环线程在回调开始时发布的数据, 不引用协程本身 (协程可能随时被销毁)
+struct LoopStall {
+    std::chrono::nanoseconds duration;  // 本次迭代已运行的时间
+    HandleId id;                        // 正在运行的回调的句柄 ID
+    std::source_location location;      // 正在运行的协程的源码位置
+    // 正在运行的协程及其等待者的源码位置 ([0] 即 location, 未保存源码位置时为空)
+    std::vector<std::source_location> backtrace;
+};
+
+using SlowCallbackHandler = std::function<void(SlowCallback const&)>;
+using LoopStallHandler = std::function<void(LoopStall const&)>;
+
+// 默认的处理函数: 输出到 stderr 并打印协程的回溯栈 (同样输出到 stderr)
+void PrintSlowCallback(SlowCallback const& report);
+void PrintLoopStall(LoopStall const& report);
+
+// 看门狗: 由事件循环持有, 后台线程每 timeout/4 检查一次事件循环是否卡住
+// NOTE: 事件循环阻塞在 Select 中等待事件是空闲, 不算卡住; 每次卡顿只报告一次
+class Watchdog : NonCopyable {
+public:
+    Watchdog(std::chrono::nanoseconds timeout, LoopStallHandler handler);
+
+    ~Watchdog();
+
+public:
+    // 以下由事件循环线程调用
+
+    // 迭代开始执行回调 (Select 返回后)
+    void BeginIteration() { busy_since_.store(Now(), std::memory_order_relaxed); }
+
+    // 迭代结束 (进入 Select 前)
+    void EndIteration() { busy_since_.store(0, std::memory_order_relaxed); }
+
+    // 开始运行一个回调: 发布句柄 ID 与协程回溯栈的源码位置 (静态存储, 看门狗线程读取时始终有效)
+    // NOTE: 不发布协程本身, 看门狗线程不访问协程
+    void BeginCallback(HandleId id, [[maybe_unused]] CoroHandle const* coroutine) {
+        callback_id_.store(id, std::memory_order_relaxed);
+        size_t depth = 0;
+#if ASYNCIO_ENABLE_FRAME_INFO
+        for (; coroutine && depth < kMaxBacktrace; coroutine = coroutine->Continuation()) {
+            backtrace_[depth++].store(coroutine->GetFrameInfo(), std::memory_order_relaxed);
+        }
+#endif
+        backtrace_depth_.store(depth, std::memory_order_release);
+    }
+
+private:
+    static int64_t Now() {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    }
+
+    void Watch();
+
+private:
+    static constexpr size_t kMaxBacktrace = 16;  // 发布的回溯栈最大深度
+
+    std::chrono::nanoseconds timeout_;
+    LoopStallHandler handler_;
+
+    std::atomic<int64_t> busy_since_{0};  // 本次迭代开始执行的时间 (0: 空闲)
+    std::atomic<HandleId> callback_id_{0};
+    // 正在运行的协程及其等待者的源码位置
+    // NOTE: 尽力而为: 报告时事件循环可能已开始下一个回调, 各层可能来自不同的回调, 但都是有效的位置
+    std::array<std::atomic<std::source_location>, kMaxBacktrace> backtrace_{};
+    std::atomic<size_t> backtrace_depth_{0};
+
+    std::mutex mutex_;
+    std::condition_variable stop_cv_;
+    bool stop_{false};
+    std::thread thread_;  // NOTE: 最后初始化, 其他成员就绪后才启动
+};
+
+}  // namespace asyncio
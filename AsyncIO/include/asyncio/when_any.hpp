@@ -0,0 +1,175 @@
+/**
+ *  并发执行多个可等待对象, 返回第一个完成者的下标和结果, 并立即取消其余任务.
+ *  第一个完成者抛出异常时, 整个 WhenAny 以该异常完成.
+ *  被取消的任务会被销毁: 其挂起的 IO 事件注册与定时器随之释放.
+ */
+
+#pragma once
+
+// std
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+// asyncio
+#include <asyncio/detail/concepts/awaitable.hpp>
+#include <asyncio/detail/noncopyable.hpp>
+#include <asyncio/detail/void_value.hpp>
+#include <asyncio/result.hpp>
+#include <asyncio/scheduled_task.hpp>
+#include <asyncio/task.hpp>
+
+namespace asyncio {
+
+namespace detail {
+
+// 每个可等待对象对应一个收集结果的任务
+template <typename>
+using WhenAnyCollector = ScheduledTask<Task<>>;
+
+template <typename... Rs>
+class WhenAnyAwaiter : NonCopyable {
+    using ValueType = std::variant<GetTypeIfVoid_t<Rs>...>;
+    using ResultType = std::pair<size_t, ValueType>;  // <第一个完成者的下标, 结果>
+
+public:
+    template <concepts::Awaitable... Futs>
+    explicit WhenAnyAwaiter(Futs&&... futs)
+        : WhenAnyAwaiter(std::make_index_sequence<sizeof...(Futs)>{},
+                         std::forward<Futs>(futs)...)  // 委托构造
+    {}
+
+    constexpr bool await_ready() noexcept { return result_.HasValue(); }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> continuation) noexcept {
+        continuation_ = &continuation.promise();
+        continuation_->SetState(Handle::SUSPEND);
+    }
+
+    auto await_resume() { return std::move(result_).GetResult(); }
+
+private:
+    // NOTE: 花括号初始化保证按参数顺序调度
+    template <concepts::Awaitable... Futs, size_t... Is>
+    explicit WhenAnyAwaiter(std::index_sequence<Is...>, Futs&&... futs)
+        : tasks_{schedule_task(CollectFirst<Is>(std::forward<Futs>(futs)))...} {}
+
+    // fut 按值保存在协程帧中: 取消 (销毁) 收集协程时会一并销毁未完成的 fut
+    template <size_t Idx, concepts::Awaitable Fut>
+    Task<> CollectFirst(Fut fut) {
+        try {
+            if constexpr (std::is_void_v<AwaitResult<Fut>>) {
+                co_await std::move(fut);
+                result_.SetValue(ResultType{Idx, ValueType{std::in_place_index<Idx>}});
+            } else {
+                result_.SetValue(
+                    ResultType{Idx, ValueType{std::in_place_index<Idx>, co_await std::move(fut)}});
+            }
+        } catch (...) {
+            result_.unhandled_exception();
+        }
+        CancelOthers(Idx, std::make_index_sequence<sizeof...(Rs)>{});
+        if (continuation_) {
+            GetEventLoop().CallSoon(*std::exchange(continuation_, nullptr));
+        }
+    }
+
+    // 取消除 winner 之外的所有任务 (winner 正在运行, 不能销毁自己)
+    template <size_t... Is>
+    void CancelOthers(size_t winner, std::index_sequence<Is...>) {
+        ((Is != winner ? std::get<Is>(tasks_).Cancel() : void()), ...);
+    }
+
+private:
+    Result<ResultType> result_;
+    std::tuple<WhenAnyCollector<Rs>...> tasks_;
+    CoroHandle* continuation_{};
+};
+
+// 运行时数量的同类型任务
+template <typename R>
+class WhenAnyRangeAwaiter : NonCopyable {
+    using ResultType = std::pair<size_t, GetTypeIfVoid_t<R>>;  // <第一个完成者的下标, 结果>
+
+public:
+    explicit WhenAnyRangeAwaiter(std::vector<Task<R>>& futs) {
+        tasks_.reserve(futs.size());
+        for (size_t i = 0; i < futs.size(); ++i) {
+            tasks_.push_back(schedule_task(CollectFirst(std::move(futs[i]), i)));
+        }
+    }
+
+    constexpr bool await_ready() noexcept { return result_.HasValue(); }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> continuation) noexcept {
+        continuation_ = &continuation.promise();
+        continuation_->SetState(Handle::SUSPEND);
+    }
+
+    auto await_resume() { return std::move(result_).GetResult(); }
+
+private:
+    Task<> CollectFirst(Task<R> fut, size_t idx) {
+        try {
+            if constexpr (std::is_void_v<R>) {
+                co_await std::move(fut);
+                result_.SetValue(ResultType{idx, VoidValue{}});
+            } else {
+                result_.SetValue(ResultType{idx, co_await std::move(fut)});
+            }
+        } catch (...) {
+            result_.unhandled_exception();
+        }
+        for (size_t i = 0; i < tasks_.size(); ++i) {
+            if (i != idx) {
+                tasks_[i].Cancel();
+            }
+        }
+        if (continuation_) {
+            GetEventLoop().CallSoon(*std::exchange(continuation_, nullptr));
+        }
+    }
+
+private:
+    Result<ResultType> result_;
+    std::vector<ScheduledTask<Task<>>> tasks_;
+    CoroHandle* continuation_{};
+};
+
+template <concepts::Awaitable... Futs>
+auto WhenAny(NoWaitAtInitialSuspend, Futs&&... futs)  // 立即执行: 在实参析构前把 futs 移入收集协程
+    -> Task<std::pair<size_t, std::variant<GetTypeIfVoid_t<AwaitResult<Futs>>...>>> {
+    co_return co_await WhenAnyAwaiter<AwaitResult<Futs>...>{std::forward<Futs>(futs)...};
+}
+
+template <typename R>
+auto WhenAny(NoWaitAtInitialSuspend, std::vector<Task<R>> futs)
+    -> Task<std::pair<size_t, GetTypeIfVoid_t<R>>> {
+    if (futs.empty()) {
+        throw std::invalid_argument("WhenAny of empty range");
+    }
+    co_return co_await WhenAnyRangeAwaiter<R>{futs};
+}
+
+}  // namespace detail
+
+// 返回第一个完成的可等待对象的下标及其结果 (std::variant), 其余任务被立即取消并销毁
+// NOTE: 可等待对象按值接管 (必须是右值), 因为失败者会被销毁
+template <concepts::Awaitable... Futs>
+    requires(sizeof...(Futs) > 0 && (!std::is_lvalue_reference_v<Futs> && ...))
+[[nodiscard("discard WhenAny doesn't make sense")]]
+auto WhenAny(Futs&&... futs) {
+    return detail::WhenAny(no_wait_at_initial_suspend, std::forward<Futs>(futs)...);
+}
+
+// 范围版本: 返回第一个完成任务的下标及其结果, 其余任务被立即取消并销毁
+template <typename R>
+[[nodiscard("discard WhenAny doesn't make sense")]]
+auto WhenAny(std::vector<Task<R>> futs) {
+    return detail::WhenAny(no_wait_at_initial_suspend, std::move(futs));
+}
+
+}  // namespace asyncio
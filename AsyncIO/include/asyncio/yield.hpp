@@ -0,0 +1,51 @@
+/**
+ *  主动让出: co_await Yield() 把当前协程放回就绪队列的队尾, 先运行其他就绪的协程,
+ *  并让事件循环在下一次迭代前轮询一次 IO 事件.
+ *  长时间计算或一直有数据可处理的循环应定期让出, 避免独占事件循环 (另见 detail/budget.hpp)
+ */
+
+#pragma once
+
+// std
+#include <coroutine>
+// asyncio
+#include <asyncio/cancellation.hpp>
+#include <asyncio/event_loop.hpp>
+#include <asyncio/exception.hpp>
+
+namespace asyncio {
+
+namespace detail {
+
+// 经 CallSoon 重新调度当前协程; 令牌已被取消时不挂起, 让出后被取消时恢复执行并抛出 CancelledError
+struct YieldAwaiter {
+    constexpr bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> caller) noexcept {
+        token_ = caller.promise().cancel_token_;
+        if (token_ && token_->IsCancelled()) {
+            return false;
+        }
+        GetEventLoop().CallSoon(caller.promise());
+        return true;
+    }
+
+    void await_resume() const {
+        if (token_ && token_->IsCancelled()) {
+            throw CancelledError{};
+        }
+    }
+
+    CancellationToken* token_{};
+};
+
+}  // namespace detail
+
+// 让出事件循环: co_await Yield();
+[[nodiscard("忽略 Yield 的返回值是说不通的!")]]
+inline detail::YieldAwaiter Yield() {
+    return {};
+}
+
+}  // namespace asyncio
@@ -0,0 +1,30 @@
+#include <asyncio/cancellation.hpp>
+
+namespace asyncio {
+
+CancellationToken::CancellationToken(CancellationToken* parent) {
+    if (parent) {
+        parent->Register(parent_link_);
+    }
+}
+
+void CancellationToken::Cancel() {
+    if (cancelled_) {
+        return;
+    }
+    cancelled_ = true;
+    // NOTE: 回调中可能注销其他回调 (例如销毁协程帧), 因此每次只取出队首
+    while (auto callback = callbacks_.PopFront()) {
+        callback->OnCancel();
+    }
+}
+
+void CancellationToken::Register(Callback& callback) {
+    if (cancelled_) {
+        callback.OnCancel();
+        return;
+    }
+    callbacks_.PushBack(callback);
+}
+
+}  // namespace asyncio
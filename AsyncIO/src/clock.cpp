@@ -0,0 +1,38 @@
+#include <asyncio/detail/clock.hpp>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace asyncio {
+
+#if defined(__x86_64__) || defined(__i386__)
+TscClock::Calibration const& TscClock::Calibration::Get() noexcept {
+    static Calibration const calibration = [] {
+        Calibration result;
+        // CPUID.80000007H:EDX[8]: invariant TSC (频率恒定, 不受变频与 C 状态影响)
+        unsigned eax{}, ebx{}, ecx{}, edx{};
+        if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) || !(edx & (1u << 8))) {
+            return result;
+        }
+        auto start = MonotonicClock::Now();
+        auto start_ticks = __builtin_ia32_rdtsc();
+        timespec delay{.tv_sec = 0, .tv_nsec = 10'000'000};
+        ::nanosleep(&delay, nullptr);
+        auto end = MonotonicClock::Now();
+        auto end_ticks = __builtin_ia32_rdtsc();
+        if (end_ticks <= start_ticks) {
+            return result;
+        }
+        result.invariant = true;
+        result.ns_per_tick =
+            static_cast<double>((end - start).count()) / static_cast<double>(end_ticks - start_ticks);
+        result.base_ticks = end_ticks;
+        result.base = end;
+        return result;
+    }();
+    return calibration;
+}
+#endif
+
+}  // namespace asyncio
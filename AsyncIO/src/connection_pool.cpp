@@ -0,0 +1,174 @@
+#include <poll.h>
+
+#include <asyncio/connection_pool.hpp>
+
+namespace asyncio {
+
+PooledStream::PooledStream(ConnectionPool& pool, std::string key, Stream stream)
+    : pool_(&pool), key_(std::move(key)) {
+    stream_.emplace(std::move(stream));
+}
+
+PooledStream::PooledStream(PooledStream&& other)
+    : pool_(std::exchange(other.pool_, nullptr)),
+      key_(std::move(other.key_)),
+      broken_(other.broken_) {
+    if (other.stream_) {
+        other.stream_->ReleaseEvents();
+        stream_.emplace(std::move(*other.stream_));
+        other.stream_.reset();
+    }
+}
+
+void PooledStream::Release() {
+    if (auto pool = std::exchange(pool_, nullptr)) {
+        pool->Release(key_, std::move(*stream_), broken_);
+        stream_.reset();
+    }
+}
+
+ConnectionPool::~ConnectionPool() {
+    if (evictor_armed_) {
+        GetEventLoop().CancelHandle(evictor_);
+    }
+}
+
+Task<PooledStream> ConnectionPool::Acquire(std::string_view host, uint16_t port) {
+    auto key = std::string{host} + ':' + std::to_string(port);
+    auto& loop = GetEventLoop();
+    auto& entry = hosts_[key];
+
+    // 1. 优先复用最近归还的空闲连接 (LIFO, 最"热"的连接最不可能被对端关闭)
+    while (!entry.idle.empty()) {
+        Stream stream{std::move(entry.idle.back().stream)};
+        entry.idle.pop_back();
+        if (IsHealthy(stream)) {
+            ++stats_.hits;
+            co_return PooledStream{*this, key, std::move(stream)};
+        }
+        ++stats_.stale;
+        --entry.total;
+    }
+
+    // 2. 达到连接上限: 排队等待归还的连接或新建连接的名额
+    if (entry.total >= options_.max_per_host) {
+        ++stats_.waits;
+        auto start = loop.time();
+        Waiter waiter{*this, entry};
+        co_await waiter;
+        auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(loop.time() - start);
+        stats_.total_wait_time += waited;
+        stats_.max_wait_time = std::max(stats_.max_wait_time, waited);
+        if (waiter.stream_) {
+            ++stats_.hits;
+            co_return PooledStream{*this, key, std::move(*waiter.stream_)};
+        }
+        // 拿到了新建连接的名额 (名额已由释放方保留在 total 中)
+    } else {
+        ++entry.total;
+    }
+
+    // 3. 新建连接
+    ++stats_.misses;
+    try {
+        co_return PooledStream{*this, key, co_await OpenConnection(host, port, options_.connect)};
+    } catch (...) {
+        ReleaseSlot(entry);
+        throw;
+    }
+}
+
+size_t ConnectionPool::IdleCount() const {
+    size_t count = 0;
+    for (auto&& [_, entry] : hosts_) {
+        count += entry.idle.size();
+    }
+    return count;
+}
+
+void ConnectionPool::Release(std::string const& key, Stream&& stream, bool broken) {
+    auto& entry = hosts_[key];
+    stream.ReleaseEvents();  // 注销读写事件: 空闲连接不占用 selector, 移交后由新持有者重新注册
+    if (broken || !IsHealthy(stream)) {
+        stream.Close();
+        ReleaseSlot(entry);
+        return;
+    }
+    if (!entry.waiters.empty()) {  // 直接移交给队首排队者
+        Wakeup(entry, std::move(stream));
+        return;
+    }
+    entry.idle.push_back({std::move(stream), GetEventLoop().time()});
+    ArmEvictor(options_.idle_timeout);
+}
+
+void ConnectionPool::ReleaseSlot(HostEntry& entry) {
+    if (!entry.waiters.empty()) {
+        Wakeup(entry, std::nullopt);
+    } else {
+        --entry.total;
+    }
+}
+
+void ConnectionPool::Wakeup(HostEntry& entry, std::optional<Stream> stream) {
+    auto waiter = entry.waiters.front();
+    entry.waiters.pop_front();
+    if (stream) {
+        waiter->stream_.emplace(std::move(*stream));
+    }
+    waiter->granted_ = true;
+    GetEventLoop().CallSoon(*waiter->continuation_);
+}
+
+void ConnectionPool::Regrant(HostEntry& entry, std::optional<Stream> stream) {
+    if (!stream) {
+        ReleaseSlot(entry);
+    } else if (!entry.waiters.empty()) {
+        Wakeup(entry, std::move(stream));
+    } else {
+        entry.idle.push_back({std::move(*stream), GetEventLoop().time()});
+        ArmEvictor(options_.idle_timeout);
+    }
+}
+
+void ConnectionPool::EvictIdle() {
+    evictor_armed_ = false;
+    auto now = GetEventLoop().time();
+    std::optional<std::chrono::nanoseconds> next_expire;
+    for (auto iter = hosts_.begin(); iter != hosts_.end();) {
+        auto& entry = iter->second;
+        // 头部最旧: 依次驱逐过期连接
+        while (!entry.idle.empty() && now - entry.idle.front().since >= options_.idle_timeout) {
+            entry.idle.pop_front();
+            --entry.total;
+            ++stats_.evictions;
+        }
+        if (!entry.idle.empty()) {
+            auto expire = entry.idle.front().since + options_.idle_timeout;
+            next_expire = next_expire ? std::min(*next_expire, expire) : expire;
+        }
+        // 没有任何连接的 host:port 不再保留
+        if (entry.total == 0 && entry.waiters.empty()) {
+            iter = hosts_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    if (next_expire) {
+        ArmEvictor(std::max(*next_expire - now, std::chrono::nanoseconds(0)));
+    }
+}
+
+void ConnectionPool::ArmEvictor(std::chrono::nanoseconds delay) {
+    if (!evictor_armed_) {
+        evictor_armed_ = true;
+        GetEventLoop().CallLater(delay, evictor_);
+    }
+}
+
+bool ConnectionPool::IsHealthy(Stream const& stream) {
+    pollfd pfd{.fd = stream.GetFd(), .events = POLLIN | POLLRDHUP, .revents = 0};
+    return ::poll(&pfd, 1, 0) == 0;
+}
+
+}  // namespace asyncio
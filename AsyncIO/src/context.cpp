@@ -0,0 +1,25 @@
+#include <asyncio/context.hpp>
+
+namespace asyncio {
+
+void Context::Set(uint32_t index, std::shared_ptr<void const> value) {
+    if (!node_) {
+        if (!value) {  // 清除未设置的变量
+            return;
+        }
+        node_ = new Node{};
+    } else if (node_->refs > 1) {  // 写时复制: 快照被其他协程共享
+        auto copy = new Node{.refs = 1, .values = node_->values};
+        --node_->refs;
+        node_ = copy;
+    }
+    if (index >= node_->values.size()) {
+        if (!value) {
+            return;
+        }
+        node_->values.resize(index + 1);
+    }
+    node_->values[index] = std::move(value);
+}
+
+}  // namespace asyncio
@@ -8,6 +8,24 @@ const std::source_location& CoroHandle::GetFrameInfo() const {
     return frame_info;
 }
 
+void CoroHandle::TracedResume() {
+    auto id = GetHandleId();  // NOTE: 协程运行结束后不再访问 this
+#if ASYNCIO_ENABLE_FRAME_INFO
+    TraceBuffer::Emit(TraceEventType::RESUME, id, GetFrameInfo());
+#else
+    TraceBuffer::Emit(TraceEventType::RESUME, id);
+#endif
+    auto prev_token = std::exchange(current_cancel_token_, cancel_token_);
+    auto prev_priority = std::exchange(current_priority_, GetPriority());
+    auto prev_context = Context::Switch(&context_);
+    detail::OperationBudget::Reset();
+    std::coroutine_handle<>::from_address(frame_).resume();
+    Context::Switch(prev_context);
+    current_priority_ = prev_priority;
+    current_cancel_token_ = prev_token;
+    TraceBuffer::Emit(TraceEventType::SUSPEND, id);
+}
+
 void CoroHandle::Schedule() {
     if (state_ == Handle::UNSCHEDULED) {
         GetEventLoop().CallSoon(*this);  // *this 是继承自 CoroHandle 的 promise_type
@@ -15,7 +33,8 @@ void CoroHandle::Schedule() {
 }
 
 void CoroHandle::Cancel() {
-    if (state_ != Handle::UNSCHEDULED) {
+    // NOTE: 只有 SCHEDULED 的句柄在就绪队列/定时任务堆中, SUSPEND 的协程由挂起它的可等待对象负责注销
+    if (state_ == Handle::SCHEDULED) {
         GetEventLoop().CancelHandle(*this);
     }
 }
@@ -0,0 +1,166 @@
+#include <asyncio/locks.hpp>
+
+namespace asyncio {
+
+namespace detail {
+
+bool SyncWaiter::Suspend(CoroHandle& coro) {
+    auto token = coro.cancel_token_;
+    if (token && token->IsCancelled()) {
+        cancelled_ = true;
+        return false;
+    }
+    coro_ = &coro;
+    coro.SetState(Handle::SUSPEND);
+    if (token) {
+        token->Register(canceller_);
+    }
+    return true;
+}
+
+void SyncWaiter::Wakeup() {
+    granted_ = true;
+    canceller_.Unlink();
+    GetEventLoop().CallSoon(*coro_);
+}
+
+void SyncWaiter::Resume() {
+    resumed_ = true;
+    canceller_.Unlink();
+    if (cancelled_) {
+        throw CancelledError{};
+    }
+}
+
+void SyncWaiter::Reschedule(CoroHandle& coro) {
+    granted_ = true;
+    coro_ = &coro;
+    GetEventLoop().CallSoon(coro);
+}
+
+void SyncWaiter::OnCancel() {
+    Unlink();
+    cancelled_ = true;
+    GetEventLoop().CallSoon(*coro_);
+}
+
+}  // namespace detail
+
+void AsyncLockGuard::Unlock() {
+    if (auto mutex = std::exchange(mutex_, nullptr)) {
+        mutex->Unlock();
+    }
+}
+
+bool AsyncMutex::TryLock() {
+    if (locked_ || !waiters_.Empty()) {
+        return false;
+    }
+    locked_ = true;
+    return true;
+}
+
+void AsyncMutex::Unlock() {
+    if (auto waiter = waiters_.PopFront()) {
+        waiter->Wakeup();  // 锁直接移交, locked_ 保持为 true
+    } else {
+        locked_ = false;
+    }
+}
+
+void AsyncMutex::Enqueue(detail::SyncWaiter& waiter) {
+    if (!locked_) {
+        locked_ = true;
+        waiter.Wakeup();
+    } else {
+        waiters_.PushBack(waiter);
+    }
+}
+
+bool AsyncSemaphore::TryAcquire() {
+    if (value_ == 0 || !waiters_.Empty()) {
+        return false;
+    }
+    --value_;
+    return true;
+}
+
+void AsyncSemaphore::Release() {
+    if (auto waiter = waiters_.PopFront()) {
+        waiter->Wakeup();  // 许可直接移交
+    } else {
+        ++value_;
+    }
+}
+
+void AsyncEvent::Set() {
+    set_ = true;
+    while (auto waiter = waiters_.PopFront()) {
+        waiter->Wakeup();
+    }
+}
+
+void AsyncCondition::Notify(size_t n) {
+    for (; n > 0; --n) {
+        auto waiter = waiters_.PopFront();
+        if (!waiter) {
+            break;
+        }
+        mutex_.Enqueue(*waiter);
+    }
+}
+
+void AsyncCondition::NotifyAll() {
+    while (auto waiter = waiters_.PopFront()) {
+        mutex_.Enqueue(*waiter);
+    }
+}
+
+bool AsyncRWLock::TryLock() {
+    if (writer_ || readers_ > 0 || !waiters_.Empty()) {
+        return false;
+    }
+    writer_ = true;
+    return true;
+}
+
+bool AsyncRWLock::TryLockShared() {
+    if (writer_ || !waiters_.Empty()) {
+        return false;
+    }
+    ++readers_;
+    return true;
+}
+
+void AsyncRWLock::Unlock() {
+    writer_ = false;
+    Dispatch();
+}
+
+void AsyncRWLock::UnlockShared() {
+    --readers_;
+    Dispatch();
+}
+
+void AsyncRWLock::Dispatch() {
+    while (auto waiter = waiters_.Front()) {
+        if (waiter->shared_) {
+            if (writer_) {
+                break;
+            }
+            ++readers_;
+        } else {
+            if (writer_ || readers_ > 0) {
+                break;
+            }
+            writer_ = true;
+        }
+        waiters_.PopFront();
+        waiter->Wakeup();
+        if (!waiter->shared_) {
+            break;
+        }
+    }
+}
+
+}  // namespace asyncio
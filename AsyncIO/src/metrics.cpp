@@ -0,0 +1,113 @@
+#include <fmt/format.h>
+
+#include <cmath>
+#include <iterator>
+//
+#include <asyncio/metrics.hpp>
+
+namespace asyncio {
+
+uint64_t LatencyHistogram::UpperBound(size_t index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    uint64_t shift = index / kSubBuckets - 1;
+    uint64_t lower = (kSubBuckets + index % kSubBuckets) << shift;
+    return lower + (uint64_t{1} << shift) - 1;
+}
+
+uint64_t LatencyHistogram::ValueAtPercentile(double percentile) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    auto target = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count_))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += counts_[i];
+        if (seen >= target) {
+            // 最后一个桶没有上界 (超出范围的值都记在这里)
+            return i + 1 == kBuckets ? max_ : std::clamp(UpperBound(i), min_, max_);
+        }
+    }
+    return max_;
+}
+
+void LatencyHistogram::Merge(LatencyHistogram const& other) {
+    for (size_t i = 0; i < kBuckets; ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+namespace {
+
+template <typename Value>
+void AppendMetric(std::string& out, std::string_view prefix, std::string_view name,
+                  std::string_view type, std::string_view help, Value value) {
+    fmt::format_to(std::back_inserter(out),
+                   "# HELP {0}_{1} {2}\n# TYPE {0}_{1} {3}\n{0}_{1} {4}\n", prefix, name, help,
+                   type, value);
+}
+
+// scale: 记录值到导出单位的换算 (纳秒 -> 秒: 1e-9)
+void AppendSummary(std::string& out, std::string_view prefix, std::string_view name,
+                   std::string_view help, LatencyHistogram const& histogram, double scale) {
+    auto it = std::back_inserter(out);
+    fmt::format_to(it, "# HELP {0}_{1} {2}\n# TYPE {0}_{1} summary\n", prefix, name, help);
+    for (double quantile : {0.5, 0.9, 0.99, 0.999}) {
+        fmt::format_to(it, "{}_{}{{quantile=\"{}\"}} {:.9g}\n", prefix, name, quantile,
+                       histogram.ValueAtPercentile(quantile * 100) * scale);
+    }
+    fmt::format_to(it, "{0}_{1}_sum {2:.9g}\n{0}_{1}_count {3}\n", prefix, name,
+                   histogram.Sum() * scale, histogram.Count());
+    fmt::format_to(it, "# HELP {0}_{1}_max Maximum of {0}_{1}.\n# TYPE {0}_{1}_max gauge\n",
+                   prefix, name);
+    fmt::format_to(it, "{}_{}_max {:.9g}\n", prefix, name, histogram.Max() * scale);
+}
+
+}  // namespace
+
+std::string FormatPrometheus(LoopMetrics const& metrics, std::string_view prefix) {
+    std::string out;
+    AppendMetric(out, prefix, "iterations_total", "counter", "Event loop iterations.",
+                 metrics.iterations);
+    AppendMetric(out, prefix, "callbacks_total", "counter",
+                 "Callbacks run (coroutine resumes and handles).", metrics.callbacks);
+    AppendMetric(out, prefix, "io_events_total", "counter", "I/O events returned by the selector.",
+                 metrics.io_events);
+    AppendMetric(out, prefix, "timers_fired_total", "counter", "Expired timers.",
+                 metrics.timers_fired);
+    AppendMetric(out, prefix, "cancelled_skipped_total", "counter",
+                 "Cancelled callbacks skipped when dequeued.", metrics.cancelled_skipped);
+    AppendMetric(out, prefix, "busy_poll_hits_total", "counter",
+                 "Busy poll windows that caught an event.", metrics.busy_poll_hits);
+    AppendMetric(out, prefix, "busy_poll_misses_total", "counter",
+                 "Busy poll windows that ended without events.", metrics.busy_poll_misses);
+    AppendMetric(out, prefix, "time_slices_expired_total", "counter",
+                 "Iterations cut short by the time slice.", metrics.time_slices_expired);
+    AppendMetric(out, prefix, "ready_size", "gauge", "Ready queue length.", metrics.ready_size);
+    AppendMetric(out, prefix, "timer_backlog", "gauge", "Pending timers, including cancelled ones.",
+                 metrics.timer_backlog);
+    AppendMetric(out, prefix, "cancelled_backlog", "gauge",
+                 "Cancellation records not yet cleaned up.", metrics.cancelled_backlog);
+    AppendMetric(out, prefix, "utilization_ratio", "gauge",
+                 "Share of loop time spent outside the selector.", metrics.Utilization());
+    AppendSummary(out, prefix, "iteration_seconds", "Iteration time excluding selector blocking.",
+                  metrics.iteration_time, 1e-9);
+    AppendSummary(out, prefix, "select_seconds", "Time blocked in the selector.",
+                  metrics.select_time, 1e-9);
+    AppendSummary(out, prefix, "callback_seconds", "Time of a single callback.",
+                  metrics.callback_time, 1e-9);
+    AppendSummary(out, prefix, "ready_depth", "Ready queue length at the start of an iteration.",
+                  metrics.ready_depth, 1);
+    AppendSummary(out, prefix, "callbacks_per_iteration", "Callbacks run per iteration.",
+                  metrics.callbacks_per_iteration, 1);
+    return out;
+}
+
+}  // namespace asyncio
@@ -1,19 +1,23 @@
 #include <asyncio/open_connection.hpp>
+#include <asyncio/scheduled_task.hpp>
+#include <asyncio/wait_for.hpp>
+#include <optional>
 #include <system_error>
+#include <vector>
 
 namespace asyncio {
 
 namespace detail {
 
-Task<bool> Connect(int fd, const sockaddr *addr, socklen_t len) noexcept {
+Task<std::error_code> Connect(int fd, const sockaddr *addr, socklen_t len) noexcept {
     int rc = ::connect(fd, addr, len);  // 非阻塞式 connect
 
     if (rc == 0) {  // 连接成功
-        co_return true;
+        co_return std::error_code{};
     }
 
-    if (rc < 0 && errno != EINPROGRESS) {  // 其他错误
-        throw std::system_error(errno, std::system_category());
+    if (rc < 0 && errno != EINPROGRESS) {  // 其他错误 (连接被拒绝/不可达)
+        co_return std::error_code(errno, std::system_category());
     }
 
     // rc == -1 且 errno == EINPROGRESS: 连接正在进行中
@@ -26,15 +30,126 @@ Task<bool> Connect(int fd, const sockaddr *addr, socklen_t len) noexcept {
     socklen_t result_len = sizeof(result);
     if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &result, &result_len) < 0) {
         // error, fail somehow, close socket
-        co_return false;
+        co_return std::error_code(errno, std::system_category());
     }
 
-    co_return result == 0;
+    co_return std::error_code(result, std::system_category());
 }
 
+namespace {
+
+// RFC 8305 §4: 按地址族交错排列 getaddrinfo 的结果, 以第一个结果的地址族开头
+std::vector<const addrinfo *> InterleaveFamilies(const addrinfo *addrs) {
+    std::vector<const addrinfo *> preferred, others;
+    for (auto p = addrs; p != nullptr; p = p->ai_next) {
+        (p->ai_family == addrs->ai_family ? preferred : others).push_back(p);
+    }
+    std::vector<const addrinfo *> result;
+    result.reserve(preferred.size() + others.size());
+    for (size_t i = 0; i < std::max(preferred.size(), others.size()); ++i) {
+        if (i < preferred.size()) {
+            result.push_back(preferred[i]);
+        }
+        if (i < others.size()) {
+            result.push_back(others[i]);
+        }
+    }
+    return result;
+}
+
+// 并行连接尝试的竞速状态
+struct ConnectRace : NonCopyable {
+    // 唤醒等待竞速结果的协程
+    void Notify() {
+        if (auto waiter = std::exchange(waiter_, nullptr)) {
+            GetEventLoop().CallSoon(*waiter);
+        }
+    }
+
+    int winner_fd_{-1};     // 第一个连接成功的 fd
+    size_t failed_{0};      // 已失败的尝试数
+    CoroHandle *waiter_{};  // 等待竞速结果的协程 (OpenConnection)
+};
+
+// 等待竞速状态变化 (某个尝试结束), 或者最多等待 timeout
+struct ConnectRaceAwaiter : NonCopyable {
+    ConnectRaceAwaiter(ConnectRace &race, std::optional<std::chrono::nanoseconds> timeout)
+        : race_(race), timeout_(timeout) {}
+
+    constexpr bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> caller) noexcept {
+        caller.promise().SetState(Handle::SUSPEND);
+        race_.waiter_ = &caller.promise();
+        if (timeout_) {
+            GetEventLoop().CallLater(*timeout_, timer_);
+        }
+    }
+
+    constexpr void await_resume() const noexcept {}
+
+    struct TimeoutHandle : Handle {
+        explicit TimeoutHandle(ConnectRace &race) : race_(race) {}
+
+        // 被竞速结果提前唤醒时取消定时
+        ~TimeoutHandle() {
+            if (state_ == Handle::SCHEDULED) {
+                GetEventLoop().CancelHandle(*this);
+            }
+        }
+
+        void Run() override final { race_.Notify(); }
+
+        ConnectRace &race_;
+    };
+
+    ConnectRace &race_;
+    std::optional<std::chrono::nanoseconds> timeout_;
+    TimeoutHandle timer_{race_};
+};
+
+// 单个地址的连接尝试: 成功且尚无胜者时把 fd 交给竞速状态, 否则 (失败或被取消时) 关闭 fd
+Task<> ConnectAttempt(ConnectRace &race, const addrinfo *addr,
+                      std::chrono::milliseconds attempt_timeout) {
+    int fd = ::socket(addr->ai_family, addr->ai_socktype | SOCK_NONBLOCK, addr->ai_protocol);
+    finally {
+        if (fd != -1) {
+            close(fd);
+        }
+    };
+
+    // NOTE: 连接被拒绝/不可达/单次尝试超时都是常见情况, 以错误码处理而不抛异常
+    bool connected = false;
+    if (fd != -1) {
+        socket::SetBlocking(fd, false);  // 设置非阻塞 (二次了)
+        if (attempt_timeout.count() > 0) {
+            auto result =
+                co_await TryWaitFor(Connect(fd, addr->ai_addr, addr->ai_addrlen), attempt_timeout);
+            connected = result.IsOk() && !*result;
+        } else {
+            connected = !co_await Connect(fd, addr->ai_addr, addr->ai_addrlen);
+        }
+    }
+
+    if (!connected) {
+        ++race.failed_;
+    } else if (race.winner_fd_ == -1) {
+        race.winner_fd_ = std::exchange(fd, -1);
+    }
+    race.Notify();
+}
+
+}  // namespace
+
 }  // namespace detail
 
-Task<Stream> OpenConnection(std::string_view ip, uint16_t port) {
+Task<Stream> OpenConnection(std::string_view ip, uint16_t port, ConnectOptions options) {
+    co_return (co_await TryOpenConnection(ip, port, options)).GetResult();  // 错误码转为异常
+}
+
+Task<Result<Stream>> TryOpenConnection(std::string_view ip, uint16_t port,
+                                       ConnectOptions options) {
     addrinfo hints{};
     hints.ai_family = AF_UNSPEC;      // 不限制地址类型 (ipv4/6)
     hints.ai_socktype = SOCK_STREAM;  // 只返回支持 TCP 协议的地址
@@ -52,31 +167,56 @@ Task<Stream> OpenConnection(std::string_view ip, uint16_t port) {
     //                 struct addrinfo **res);
     // ==================================================================================
     if (int rv = getaddrinfo(ip.data(), service.c_str(), &hints, &server_info); rv != 0) {
-        throw std::system_error(std::make_error_code(std::errc::address_not_available));
+        co_return std::make_error_code(std::errc::address_not_available);
     }
     finally { freeaddrinfo(server_info); };  // go defer 函数退出时执行
 
-    int sockfd = -1;
-    for (auto p = server_info; p != nullptr; p = p->ai_next) {
-        if ((sockfd = ::socket(p->ai_family, p->ai_socktype | SOCK_NONBLOCK, p->ai_protocol)) ==
-            -1) {
-            continue;
+    co_return co_await detail::ConnectAddresses(server_info, options);
+}
+
+namespace detail {
+
+Task<Result<Stream>> ConnectAddresses(const addrinfo *server_info, ConnectOptions options) {
+    auto &loop = GetEventLoop();
+    auto addrs = detail::InterleaveFamilies(server_info);
+    std::optional<std::chrono::nanoseconds> deadline;
+    if (options.connect_timeout.count() > 0) {
+        deadline = loop.time() + options.connect_timeout;
+    }
+
+    detail::ConnectRace race;
+    // NOTE: 在调用方 freeaddrinfo 之前析构 (取消未完成的尝试)
+    std::vector<ScheduledTask<Task<>>> attempts;
+    attempts.reserve(addrs.size());
+    while (race.winner_fd_ == -1) {
+        if (deadline && loop.time() >= *deadline) {
+            co_return std::make_error_code(std::errc::timed_out);
         }
-        socket::SetBlocking(sockfd, false);  // 设置非阻塞 (二次了)
-        if (co_await detail::Connect(sockfd, p->ai_addr, p->ai_addrlen)) {
-            break;
-        } else {
-            // 如果 connect 失败了则关闭套接字
-            close(sockfd);
-            sockfd = -1;
+        bool has_more = attempts.size() < addrs.size();
+        if (!has_more && race.failed_ == attempts.size()) {  // 所有地址都连接失败
+            co_return std::make_error_code(std::errc::address_not_available);
         }
-    }
 
-    if (sockfd == -1) {
-        throw std::system_error(std::make_error_code(std::errc::address_not_available));
+        // 启动下一个地址的连接尝试 (首次, 上一个尝试失败, 或等待 attempt_delay 之后)
+        std::optional<std::chrono::nanoseconds> wait;
+        if (has_more) {
+            attempts.emplace_back(schedule_task(
+                detail::ConnectAttempt(race, addrs[attempts.size()], options.attempt_timeout)));
+            if (attempts.size() < addrs.size()) {
+                wait = options.attempt_delay;
+            }
+        }
+        if (deadline) {
+            auto remain = std::max(*deadline - loop.time(), std::chrono::nanoseconds(0));
+            wait = wait ? std::min(*wait, remain) : remain;
+        }
+        co_await detail::ConnectRaceAwaiter{race, wait};
     }
 
-    co_return Stream{sockfd};  // 返回一个已连接的 fd 构造的网络流
+    attempts.clear();  // 取消其余仍在进行的连接尝试 (关闭其 fd)
+    co_return Result<Stream>{Stream{race.winner_fd_}};  // 返回一个已连接的 fd 构造的网络流
 }
 
-}  // namespace asyncio
\ No newline at end of file
+}  // namespace detail
+
+}  // namespace asyncio
@@ -37,6 +37,14 @@ bool SetBlocking(int fd, bool blocking) {
     }
 }
 
+Result<void> SetBusyPoll(int fd, std::chrono::microseconds budget) {
+    int usec = static_cast<int>(budget.count());
+    if (::setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec)) != 0) {
+        return std::error_code(errno, std::system_category());
+    }
+    return Result<void>::Ok();
+}
+
 }  // namespace socket
 
 const void* GetInAddr(const sockaddr* sa) {
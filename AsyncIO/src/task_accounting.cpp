@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+//
+#include <asyncio/context.hpp>
+#include <asyncio/handle.hpp>
+#include <asyncio/task_accounting.hpp>
+
+namespace asyncio {
+
+namespace {
+
+constexpr uint32_t kCallbacksId = 0;
+constexpr uint32_t kUnlabeledId = 1;
+
+// 标签名 <-> 编号 (全局, 不回收)
+struct LabelRegistry {
+    LabelRegistry() {
+        Intern(TaskAccounting::kCallbacksLabel);  // kCallbacksId
+        Intern(TaskAccounting::kUnlabeled);       // kUnlabeledId
+    }
+
+    uint32_t Intern(std::string_view label) {
+        auto [iter, inserted] = ids.try_emplace(std::string{label}, names.size());
+        if (inserted) {
+            names.emplace_back(label);
+        }
+        return iter->second;
+    }
+
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint32_t> ids;
+};
+
+LabelRegistry& Registry() {
+    static LabelRegistry registry;
+    return registry;
+}
+
+// 协程上下文中的标签编号
+ContextVar<uint32_t>& LabelVar() {
+    static ContextVar<uint32_t> label;
+    return label;
+}
+
+}  // namespace
+
+void SetTaskLabel(std::string_view label) { LabelVar().Set(TaskAccounting::InternLabel(label)); }
+
+uint32_t TaskAccounting::InternLabel(std::string_view label) { return Registry().Intern(label); }
+
+uint32_t TaskAccounting::Resolve(CoroHandle const* coroutine) {
+    if (!coroutine) {
+        return kCallbacksId;
+    }
+    if (auto label = LabelVar().Get(coroutine->context_)) {
+        return *label;
+    }
+#if ASYNCIO_ENABLE_FRAME_INFO
+    // 顶层任务: co_await 链最外层的协程
+    auto root = coroutine;
+    while (auto caller = root->Continuation()) {
+        root = caller;
+    }
+    // NOTE: 函数名指向静态存储, 按指针缓存避免每次回调计算字符串哈希
+    auto name = root->GetFrameInfo().function_name();
+    auto [iter, inserted] = root_labels_.try_emplace(name, 0);
+    if (inserted) {
+        iter->second = InternLabel(name);
+    }
+    return iter->second;
+#else
+    return kUnlabeledId;
+#endif
+}
+
+uint32_t TaskAccounting::BeginRun(CoroHandle const* coroutine,
+                                  std::chrono::steady_clock::time_point now) {
+    auto label = Resolve(coroutine);
+    if (label >= counters_.size()) {
+        counters_.resize(label + 1);
+    }
+    auto& counters = counters_[label];
+    ++counters.wakeups;
+    if (coroutine) {
+        if (auto iter = suspended_since_.find(coroutine); iter != suspended_since_.end()) {
+            counters.suspended_time +=
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now - iter->second).count();
+        }
+    }
+    return label;
+}
+
+void TaskAccounting::EndRun(uint32_t label, CoroHandle const* alive,
+                            std::chrono::steady_clock::time_point start,
+                            std::chrono::steady_clock::time_point end) {
+    if (label < counters_.size()) {  // NOTE: 回调中可能重新开启统计
+        auto& counters = counters_[label];
+        auto run = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        counters.cpu_time += run;
+        counters.max_run = std::max(counters.max_run, run);
+    }
+    if (alive) {
+        suspended_since_.insert_or_assign(alive, end);
+    }
+}
+
+std::vector<TaskStats> TaskAccounting::Stats() const {
+    auto const& names = Registry().names;
+    std::vector<TaskStats> stats;
+    for (uint32_t label = 0; label < counters_.size(); ++label) {
+        auto const& counters = counters_[label];
+        if (counters.wakeups == 0) {
+            continue;
+        }
+        stats.push_back({
+            .label = names[label],
+            .wakeups = counters.wakeups,
+            .cpu_time = std::chrono::nanoseconds(counters.cpu_time),
+            .max_run = std::chrono::nanoseconds(counters.max_run),
+            .suspended_time = std::chrono::nanoseconds(counters.suspended_time),
+        });
+    }
+    return stats;
+}
+
+std::vector<TaskStats> TaskAccounting::Top(size_t n, TaskStatsOrder order) const {
+    auto key = [order](TaskStats const& stats) -> uint64_t {
+        switch (order) {
+            case TaskStatsOrder::WAKEUPS:
+                return stats.wakeups;
+            case TaskStatsOrder::MAX_RUN:
+                return stats.max_run.count();
+            case TaskStatsOrder::SUSPENDED_TIME:
+                return stats.suspended_time.count();
+            default:
+                return stats.cpu_time.count();
+        }
+    };
+    auto stats = Stats();
+    n = std::min(n, stats.size());
+    std::partial_sort(stats.begin(), stats.begin() + n, stats.end(),
+                      [&](TaskStats const& a, TaskStats const& b) { return key(a) > key(b); });
+    stats.resize(n);
+    return stats;
+}
+
+void TaskAccounting::Reset() { counters_.clear(); }
+
+}  // namespace asyncio
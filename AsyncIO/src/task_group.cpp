@@ -0,0 +1,30 @@
+#include <asyncio/task_group.hpp>
+
+namespace asyncio {
+
+Task<> TaskGroup::Wait() {
+    co_await WaitAwaiter{*this};
+    children_.clear();
+    finished_ = 0;
+    if (exception_) {
+        std::rethrow_exception(std::exchange(exception_, nullptr));
+    }
+    if (parent_token_ && parent_token_->IsCancelled()) {
+        throw CancelledError{};
+    }
+}
+
+void TaskGroup::OnChildDone() {
+    --running_;
+    ++finished_;
+    if (running_ == 0 && waiter_) {
+        GetEventLoop().CallSoon(*std::exchange(waiter_, nullptr));
+    }
+}
+
+void TaskGroup::Compact() {
+    std::erase_if(children_, [](Task<> const& child) { return child.IsDone(); });
+    finished_ = 0;
+}
+
+}  // namespace asyncio
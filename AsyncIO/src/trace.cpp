@@ -0,0 +1,136 @@
+#include <fmt/format.h>
+
+#include <bit>
+#include <iterator>
+#include <unordered_map>
+//
+#include <asyncio/trace.hpp>
+
+namespace asyncio {
+
+TraceBuffer::TraceBuffer(size_t capacity)
+    : events_(std::bit_ceil(std::max<size_t>(capacity, 1))), mask_(events_.size() - 1) {}
+
+namespace {
+
+// 追加 JSON 字符串内容 (转义引号, 反斜杠与控制字符)
+void AppendEscaped(std::string& out, std::string_view text) {
+    for (char c : text) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    fmt::format_to(std::back_inserter(out), "\\u{:04x}", c);
+                } else {
+                    out += c;
+                }
+        }
+    }
+}
+
+bool HasLocation(std::source_location const& location) { return location.line() != 0; }
+
+}  // namespace
+
+std::string TraceBuffer::ToChromeJson() const {
+    std::string out = R"({"displayTimeUnit":"ns","traceEvents":[)"
+                      R"({"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"event loop"}})";
+    if (Size() == 0) {
+        return out + "]}\n";
+    }
+
+    int64_t origin = events_[(written_ - Size()) & mask_].time;  // 最旧的事件作为时间零点
+    auto ts = [origin](int64_t time) { return static_cast<double>(time - origin) / 1000.0; };
+
+    std::unordered_map<uint64_t, std::source_location> locations;  // 句柄 ID -> 创建位置
+    std::unordered_map<uint64_t, TraceEvent> running;              // 句柄 ID -> RESUME 事件
+    auto it = std::back_inserter(out);
+
+    // 切片名: 协程的函数名 (没有源码位置时为 "coroutine #id")
+    auto append_name = [&](uint64_t id, std::source_location location) {
+        if (!HasLocation(location)) {
+            if (auto iter = locations.find(id); iter != locations.end()) {
+                location = iter->second;
+            }
+        }
+        out += R"(,{"name":")";
+        if (HasLocation(location)) {
+            AppendEscaped(out, location.function_name());
+        } else {
+            fmt::format_to(it, "coroutine #{}", id);
+        }
+        out += '"';
+    };
+    auto append_location = [&](uint64_t id, std::source_location location) {
+        if (!HasLocation(location)) {
+            if (auto iter = locations.find(id); iter != locations.end()) {
+                location = iter->second;
+            }
+        }
+        fmt::format_to(it, R"(,"args":{{"id":{})", id);
+        if (HasLocation(location)) {
+            out += R"(,"location":")";
+            AppendEscaped(out, location.file_name());
+            fmt::format_to(it, ":{}\"", location.line());
+        }
+        out += "}}";
+    };
+    auto append_instant = [&](std::string_view name, TraceEvent const& event) {
+        fmt::format_to(it,
+                       R"(,{{"name":"{}","cat":"loop","ph":"i","s":"t","ts":{:.3f},"pid":1,"tid":1,)"
+                       R"("args":{{"id":{}}}}})",
+                       name, ts(event.time), event.id);
+    };
+
+    ForEach([&](TraceEvent const& event) {
+        switch (event.type) {
+            case TraceEventType::CREATE:
+                if (HasLocation(event.location)) {
+                    locations[event.id] = event.location;
+                }
+                append_name(event.id, event.location);
+                fmt::format_to(it, R"(,"cat":"task","ph":"b","id":{},"ts":{:.3f},"pid":1,"tid":1}})",
+                               event.id, ts(event.time));
+                break;
+            case TraceEventType::FINAL_SUSPEND:
+                append_name(event.id, event.location);
+                fmt::format_to(it, R"(,"cat":"task","ph":"e","id":{},"ts":{:.3f},"pid":1,"tid":1}})",
+                               event.id, ts(event.time));
+                locations.erase(event.id);
+                break;
+            case TraceEventType::RESUME:
+                running[event.id] = event;
+                break;
+            case TraceEventType::SUSPEND:
+                // 开始事件已被覆盖的运行不输出
+                if (auto iter = running.find(event.id); iter != running.end()) {
+                    auto const& resume = iter->second;
+                    append_name(resume.id, resume.location);
+                    fmt::format_to(it,
+                                   R"(,"cat":"run","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":1)",
+                                   ts(resume.time), ts(event.time) - ts(resume.time));
+                    append_location(resume.id, resume.location);
+                    running.erase(iter);
+                }
+                break;
+            case TraceEventType::SCHEDULE:
+                append_instant("schedule", event);
+                break;
+            case TraceEventType::IO_WAIT:
+                append_instant("io wait", event);
+                break;
+            case TraceEventType::TIMER:
+                append_instant("timer", event);
+                break;
+        }
+    });
+    out += "]}\n";
+    return out;
+}
+
+}  // namespace asyncio
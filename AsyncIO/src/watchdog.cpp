@@ -0,0 +1,92 @@
+#include <fmt/format.h>
+
+#include <cstdio>
+//
+#include <asyncio/watchdog.hpp>
+
+namespace asyncio {
+
+namespace {
+
+// 源码位置的名字
+std::string LocationName(std::source_location const& location) {
+    return fmt::format("{} at {}:{}", location.function_name(), location.file_name(),
+                       location.line());
+}
+
+// 回调的名字: 存活的协程用 FrameName(), 否则用源码位置或句柄 ID
+std::string CallbackName(HandleId id, std::source_location const& location,
+                         CoroHandle const* coroutine) {
+    if (coroutine) {
+        return coroutine->FrameName();
+    }
+    if (location.line() != 0) {
+        return LocationName(location);
+    }
+    return fmt::format("handle #{}", id);
+}
+
+double Milliseconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+}  // namespace
+
+void PrintSlowCallback(SlowCallback const& report) {
+    fmt::println(stderr, "asyncio: slow callback took {:.3f} ms: {}", Milliseconds(report.duration),
+                 CallbackName(report.id, report.location, report.coroutine));
+    // NOTE: 不用 DumpBacktrace(), 它输出到 stdout
+    size_t depth = 0;
+    for (auto coroutine = report.coroutine; coroutine; coroutine = coroutine->Continuation()) {
+        fmt::println(stderr, "[{}] {}", depth++, coroutine->FrameName());
+    }
+}
+
+void PrintLoopStall(LoopStall const& report) {
+    fmt::println(stderr, "asyncio: event loop stalled for {:.3f} ms in {}",
+                 Milliseconds(report.duration), CallbackName(report.id, report.location, nullptr));
+    for (size_t depth = 0; depth < report.backtrace.size(); ++depth) {
+        fmt::println(stderr, "[{}] {}", depth, LocationName(report.backtrace[depth]));
+    }
+}
+
+Watchdog::Watchdog(std::chrono::nanoseconds timeout, LoopStallHandler handler)
+    : timeout_(timeout), handler_(std::move(handler)), thread_([this] { Watch(); }) {}
+
+Watchdog::~Watchdog() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    stop_cv_.notify_one();
+    thread_.join();
+}
+
+void Watchdog::Watch() {
+    int64_t reported = 0;  // 已报告过的迭代 (按开始时间区分)
+    std::unique_lock lock(mutex_);
+    while (!stop_cv_.wait_for(lock, timeout_ / 4, [this] { return stop_; })) {
+        auto since = busy_since_.load(std::memory_order_relaxed);
+        if (since == 0 || since == reported) {
+            continue;
+        }
+        auto duration = std::chrono::nanoseconds(Now() - since);
+        if (duration < timeout_) {
+            continue;
+        }
+        reported = since;
+        std::vector<std::source_location> backtrace(
+            backtrace_depth_.load(std::memory_order_acquire));
+        for (size_t depth = 0; depth < backtrace.size(); ++depth) {
+            backtrace[depth] = backtrace_[depth].load(std::memory_order_relaxed);
+        }
+        handler_({
+            .duration = duration,
+            .id = callback_id_.load(std::memory_order_relaxed),
+            .location = backtrace.empty() ? std::source_location{} : backtrace.front(),
+            .backtrace = std::move(backtrace),
+        });
+    }
+}
+
+}  // namespace asyncio
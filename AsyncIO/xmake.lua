@@ -1,6 +1,16 @@
+-- xmake f --usdt=y: 编译 USDT 静态探针 (需要 systemtap-sdt-dev 提供的 sys/sdt.h)
+option("usdt", function()
+    set_default(false)
+    set_showmenu(true)
+    set_description("Enable USDT probes for bpftrace/perf (requires sys/sdt.h)")
+    add_defines("ASYNCIO_ENABLE_USDT=1")
+end)
+
 target("asyncio", function()
     set_kind("static")
     add_files("src/**.cpp")
     add_includedirs("include", { public = true })
     add_packages("fmt")
+    add_syslinks("pthread", { public = true })  -- 看门狗线程
+    add_options("usdt", { public = true })
 end)
@@ -0,0 +1,100 @@
+// 基准测试的公共部分: 收集结果, 输出文本表格或 JSON
+// - 默认每个结果输出一行 "名字 数值 单位"
+// - --json <文件>: 同时把结果写成 JSON, 由 tools/bench/run.py 汇总, tools/bench/compare.py 与基线对比
+// - 单位以 "/s" 结尾的是吞吐量 (越大越好), 其余是耗时 (越小越好)
+#pragma once
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+
+// 从 start 到现在的秒数
+inline double Seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+class Reporter {
+public:
+    // suite: 基准测试名 (通常为可执行文件名)
+    Reporter(std::string_view suite, int argc, char** argv) : suite_(suite) {
+        for (int i = 1; i + 1 < argc; ++i) {
+            if (std::string_view{argv[i]} == "--json") {
+                json_path_ = argv[i + 1];
+            }
+        }
+    }
+
+    Reporter(Reporter const&) = delete;
+    Reporter& operator=(Reporter const&) = delete;
+
+    ~Reporter() {
+        if (!json_path_.empty()) {
+            WriteJson();
+        }
+    }
+
+public:
+    // 记录并输出一个结果
+    void Add(std::string name, double value, std::string_view unit) {
+        fmt::print("{:<48} {:>12.2f} {}\n", name, value, unit);
+        std::fflush(stdout);
+        results_.push_back({std::move(name), value, std::string{unit}});
+    }
+
+    // 输出一个小标题 (只在文本中)
+    void Section(std::string_view title) { fmt::print("\n{}\n", title); }
+
+private:
+    static std::string Escape(std::string_view text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out;
+    }
+
+    void WriteJson() const {
+        auto file = std::fopen(json_path_.c_str(), "w");
+        if (!file) {
+            fmt::print(stderr, "cannot write {}\n", json_path_);
+            return;
+        }
+#ifdef NDEBUG
+        constexpr std::string_view build = "release";
+#else
+        constexpr std::string_view build = "debug";
+#endif
+        fmt::print(file, "{{\"suite\":\"{}\",\"build\":\"{}\",\"results\":[", Escape(suite_), build);
+        for (size_t i = 0; i < results_.size(); ++i) {
+            auto const& result = results_[i];
+            bool higher = std::string_view{result.unit}.ends_with("/s");
+            fmt::print(file, "{}\n{{\"name\":\"{}\",\"value\":{:.6g},\"unit\":\"{}\",\"better\":\"{}\"}}",
+                       i ? "," : "", Escape(result.name), result.value, Escape(result.unit),
+                       higher ? "higher" : "lower");
+        }
+        fmt::print(file, "\n]}}\n");
+        std::fclose(file);
+    }
+
+private:
+    struct Result {
+        std::string name;
+        double value;
+        std::string unit;
+    };
+
+    std::string suite_;
+    std::string json_path_;
+    std::vector<Result> results_;
+};
+
+}  // namespace bench
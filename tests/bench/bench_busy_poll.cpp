@@ -0,0 +1,72 @@
+// 唤醒延迟 (wake-to-run): 另一个线程写入套接字到事件循环上的协程开始运行的时间分布,
+// 对比阻塞在 Select 中与忙轮询 (EventLoop::EnableBusyPoll)
+// NOTE: 忙轮询占满一个核心, 需要写入线程运行在另一个核心上才有意义 (单核机器上结果没有参考价值)
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kWakeups = 20'000;
+
+// 写入线程: 以随机间隔写入当前时间, 协程读出后记录延迟
+void Bench(bench::Reporter& report, std::string_view name) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) != 0) {
+        throw std::system_error(errno, std::system_category());
+    }
+    std::thread writer{[peer_fd = fds[1]] {
+        std::mt19937 rng{42};
+        std::uniform_int_distribution<int> gap{20, 200};  // 微秒
+        for (size_t i = 0; i < kWakeups; ++i) {
+            std::this_thread::sleep_for(std::chrono::microseconds(gap(rng)));
+            auto sent = Clock::now().time_since_epoch().count();
+            [[maybe_unused]] auto written = ::write(peer_fd, &sent, sizeof(sent));
+        }
+    }};
+
+    LatencyHistogram latency;
+    Run([&latency, local_fd = fds[0]]() -> Task<> {
+        Stream local{local_fd};
+        for (size_t received = 0; received < kWakeups;) {
+            auto data = co_await local.Read(64 * sizeof(Clock::rep));
+            auto now = Clock::now().time_since_epoch().count();
+            // NOTE: 写入线程每次写 8 字节, 落后时一次读出多个, 只记录最后一个的延迟
+            Clock::rep sent;
+            std::memcpy(&sent, data.data() + data.size() - sizeof(sent), sizeof(sent));
+            latency.Record(Clock::duration(now - sent));
+            received += data.size() / sizeof(sent);
+        }
+    }());
+    writer.join();
+    ::close(fds[1]);
+
+    report.Add(fmt::format("wake-to-run p50 <{}>", name), latency.ValueAtPercentile(50) / 1e3, "us");
+    report.Add(fmt::format("wake-to-run p99 <{}>", name), latency.ValueAtPercentile(99) / 1e3, "us");
+    report.Add(fmt::format("wake-to-run max <{}>", name), latency.Max() / 1e3, "us");
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_busy_poll", argc, argv};
+    auto& loop = GetEventLoop();
+
+    Bench(report, "blocking");
+    loop.EnableBusyPoll(50us, false);
+    Bench(report, "busy poll 50us");
+    loop.EnableBusyPoll(200us, false);
+    Bench(report, "busy poll 200us");
+    loop.EnableBusyPoll(200us, true);
+    Bench(report, "adaptive 200us");
+    loop.DisableBusyPoll();
+    return 0;
+}
@@ -0,0 +1,81 @@
+// 通道吞吐量: 单个事件循环上生产者 -> 消费者的消息数/秒
+#include <asyncio/asyncio.hpp>
+#include <array>
+#include <chrono>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+
+constexpr size_t kMessages = 1'000'000;
+
+template <typename Fn>
+void Bench(bench::Reporter& report, std::string_view name, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    Run(fn());
+    report.Add(std::string{name}, kMessages / bench::Seconds(start) / 1e6, "M msg/s");
+}
+
+template <typename Chan>
+Task<> Produce(Chan& channel) {
+    for (size_t i = 0; i < kMessages; ++i) {
+        co_await channel.Send(i);
+    }
+    channel.Close();
+}
+
+template <typename Chan>
+Task<> ConsumeOne(Chan& channel) {
+    size_t sum = 0;
+    while (auto value = co_await channel.Recv()) {
+        sum += *value;
+    }
+}
+
+template <typename Chan>
+Task<> ConsumeMany(Chan& channel) {
+    std::array<size_t, 256> buffer{};
+    size_t sum = 0;
+    while (size_t n = co_await channel.RecvMany(buffer)) {
+        for (size_t i = 0; i < n; ++i) {
+            sum += buffer[i];
+        }
+    }
+}
+
+template <typename Chan, bool Batch>
+Task<> Pipeline(Chan& channel) {
+    TaskGroup group;
+    group.Spawn(Produce(channel));
+    if constexpr (Batch) {
+        group.Spawn(ConsumeMany(channel));
+    } else {
+        group.Spawn(ConsumeOne(channel));
+    }
+    co_await group.Wait();
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_channel", argc, argv};
+    {
+        Channel<size_t> channel{1024};
+        Bench(report, "Channel(1024) Recv", [&] { return Pipeline<decltype(channel), false>(channel); });
+    }
+    {
+        Channel<size_t> channel{1024};
+        Bench(report, "Channel(1024) RecvMany", [&] { return Pipeline<decltype(channel), true>(channel); });
+    }
+    {
+        Channel<size_t> channel;
+        Bench(report, "Channel(unbounded) RecvMany", [&] { return Pipeline<decltype(channel), true>(channel); });
+    }
+    {
+        SpscChannel<size_t> channel{1024};
+        Bench(report, "SpscChannel(1024) Recv", [&] { return Pipeline<decltype(channel), false>(channel); });
+    }
+    {
+        SpscChannel<size_t> channel{1024};
+        Bench(report, "SpscChannel(1024) RecvMany", [&] { return Pipeline<decltype(channel), true>(channel); });
+    }
+    return 0;
+}
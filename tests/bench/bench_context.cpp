@@ -0,0 +1,72 @@
+// 上下文变量开销: 查找, 写时复制, 以及协程创建时的继承
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+
+constexpr size_t kLookups = 10'000'000;
+constexpr size_t kCoroutines = 2'000'000;
+
+ContextVar<uint64_t> trace_id;
+ContextVar<int> tenant;
+
+Task<> Work() { co_return; }
+
+template <typename Fn>
+void Bench(bench::Reporter& report, std::string_view name, size_t count, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    Run(fn());
+    report.Add(std::string{name}, bench::Seconds(start) / count * 1e9, "ns/op");
+}
+
+// 协程创建 + 销毁 (不运行)
+Task<> CreateCoroutines() {
+    for (size_t i = 0; i < kCoroutines; ++i) {
+        auto task = Work();
+    }
+    co_return;
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_context", argc, argv};
+    Bench(report, "Get (unset)", kLookups, []() -> Task<> {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < kLookups; ++i) {
+            sum += trace_id.ValueOr(i);
+        }
+        fmt::println("checksum {}", sum);
+        co_return;
+    });
+    Bench(report, "Get (set)", kLookups, []() -> Task<> {
+        trace_id.Set(1);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < kLookups; ++i) {
+            sum += *trace_id.Get();
+        }
+        fmt::println("checksum {}", sum);
+        co_return;
+    });
+    Bench(report, "Set (unshared, in place)", kLookups / 10, []() -> Task<> {
+        for (size_t i = 0; i < kLookups / 10; ++i) {
+            trace_id.Set(i);
+        }
+        co_return;
+    });
+    Bench(report, "Set (shared, copy-on-write)", kLookups / 10, []() -> Task<> {
+        tenant.Set(1);
+        for (size_t i = 0; i < kLookups / 10; ++i) {
+            auto child = Work();  // 子协程共享快照
+            trace_id.Set(i);
+        }
+        co_return;
+    });
+    Bench(report, "create coroutine (empty context)", kCoroutines, CreateCoroutines);
+    Bench(report, "create coroutine (inherit 2 vars)", kCoroutines, []() -> Task<> {
+        trace_id.Set(1);
+        tenant.Set(2);
+        co_await CreateCoroutines();
+    });
+    return 0;
+}
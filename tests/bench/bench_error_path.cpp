@@ -0,0 +1,83 @@
+// 错误路径开销: 抛异常的 API 与返回错误码的 Try* API 在高频失败场景下的每次操作耗时
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+
+template <typename Fn>
+void Bench(bench::Reporter& report, std::string_view name, size_t count, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    Run(fn());
+    report.Add(std::string{name}, bench::Seconds(start) / count * 1e9, "ns/op");
+}
+
+constexpr size_t kWrites = 200'000;
+constexpr size_t kConnects = 20'000;
+
+// 对端已关闭的网络流
+// NOTE: 在协程内创建, 保证 Run() 结束前注销读写事件
+Stream ClosedPeerStream() {
+    int fds[2];
+    ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds);
+    ::close(fds[1]);
+    return Stream{fds[0]};
+}
+
+// 向已关闭的对端写入: 每次都以 EPIPE 失败
+Task<> WriteThrow() {
+    auto stream = ClosedPeerStream();
+    Stream::Buffer buf(1, 'x');
+    size_t failed = 0;
+    for (size_t i = 0; i < kWrites; ++i) {
+        try {
+            co_await stream.Write(buf);
+        } catch (std::system_error const&) {
+            ++failed;
+        }
+    }
+}
+
+Task<> WriteNoThrow() {
+    auto stream = ClosedPeerStream();
+    Stream::Buffer buf(1, 'x');
+    size_t failed = 0;
+    for (size_t i = 0; i < kWrites; ++i) {
+        if (!co_await stream.TryWrite(buf)) {
+            ++failed;
+        }
+    }
+}
+
+// 连接未监听的端口: 每次都被拒绝
+constexpr uint16_t kClosedPort = 8998;
+
+Task<> ConnectThrow() {
+    size_t failed = 0;
+    for (size_t i = 0; i < kConnects; ++i) {
+        try {
+            co_await OpenConnection("127.0.0.1", kClosedPort);
+        } catch (std::system_error const&) {
+            ++failed;
+        }
+    }
+}
+
+Task<> ConnectNoThrow() {
+    size_t failed = 0;
+    for (size_t i = 0; i < kConnects; ++i) {
+        if (!co_await TryOpenConnection("127.0.0.1", kClosedPort)) {
+            ++failed;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_error_path", argc, argv};
+    Bench(report, "Write (throw) to closed peer", kWrites, WriteThrow);
+    Bench(report, "TryWrite (error code) to closed peer", kWrites, WriteNoThrow);
+    Bench(report, "OpenConnection (throw) refused", kConnects, ConnectThrow);
+    Bench(report, "TryOpenConnection (error code) refused", kConnects, ConnectNoThrow);
+    return 0;
+}
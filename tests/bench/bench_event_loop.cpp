@@ -0,0 +1,165 @@
+// 事件循环策略矩阵: 各 Selector / TimerQueue / ReadyQueue 组合的吞吐量, 以及各时钟策略的读取耗时
+// NOTE: 直接驱动局部的 BasicEventLoop (普通句柄), 不依赖全局事件循环的策略配置
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr size_t kDispatches = 2'000'000;  // 就绪队列分派次数
+constexpr size_t kReadyHandles = 1'000;    // 同时就绪的句柄数
+constexpr size_t kTimers = 200'000;        // 定时器数量 (其中一半被取消)
+constexpr size_t kSelects = 20'000;        // Select 调用次数
+constexpr size_t kClockReads = 10'000'000;  // 时钟读取次数
+
+// 每次运行后重新加入就绪队列, 直到用完分派次数
+template <typename Loop>
+struct RepostHandle : Handle {
+    RepostHandle(Loop& loop, size_t& remain) : loop_(loop), remain_(remain) {}
+
+    void Run() override {
+        if (remain_ > 0) {
+            --remain_;
+            loop_.CallSoon(*this);
+        }
+    }
+
+    Loop& loop_;
+    size_t& remain_;
+};
+
+struct NopHandle : Handle {
+    void Run() override {}
+};
+
+template <typename Loop>
+double BenchReady() {
+    Loop loop;
+    size_t remain = kDispatches;
+    std::vector<RepostHandle<Loop>> handles;
+    handles.reserve(kReadyHandles);
+    for (size_t i = 0; i < kReadyHandles; ++i) {
+        handles.emplace_back(loop, remain);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (auto& handle : handles) {
+        loop.CallSoon(handle);
+    }
+    loop.RunUntilComplete();
+    return kDispatches / bench::Seconds(start) / 1e6;
+}
+
+template <typename Loop>
+double BenchTimers() {
+    Loop loop;
+    std::vector<NopHandle> handles(kTimers);
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> delay{0, 20};
+    auto start = std::chrono::steady_clock::now();
+    for (auto& handle : handles) {
+        loop.CallLater(std::chrono::milliseconds(delay(rng)), handle);
+    }
+    for (size_t i = 0; i < kTimers; i += 2) {
+        loop.CancelHandle(handles[i]);
+    }
+    loop.RunUntilComplete();
+    return kTimers / bench::Seconds(start) / 1e6;
+}
+
+// connections 个空闲连接中只有 8 个可读
+template <typename Selector>
+double BenchSelect(size_t connections) {
+    Selector selector;
+    std::vector<int> fds;
+    std::vector<Event> events(connections);
+    NopHandle handle;
+    for (size_t i = 0; i < connections; ++i) {
+        int pair[2];
+        ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair);
+        fds.insert(fds.end(), {pair[0], pair[1]});
+        if (i % (connections / 8) == 0) {
+            ::write(pair[1], "x", 1);
+        }
+        events[i] = Event{.fd = pair[0],
+                          .flags = Event::EVENT_READ,
+                          .handle_info = {.id = handle.GetHandleId(), .handle = &handle}};
+        selector.RegisterEvent(events[i]);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kSelects; ++i) {
+        selector.Select(0ns);
+    }
+    double elapsed = bench::Seconds(start);
+    for (auto& event : events) {
+        selector.RemoveEvent(event);
+    }
+    for (int fd : fds) {
+        ::close(fd);
+    }
+    return elapsed / kSelects * 1e6;
+}
+
+template <typename Clock>
+double BenchClock() {
+    Clock::Now();  // TscClock 首次使用时校准
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kClockReads; ++i) {
+        Clock::Now();  // clock_gettime 与 rdtsc 都不会被优化掉
+    }
+    return bench::Seconds(start) / kClockReads * 1e9;
+}
+
+template <typename Selector, typename Timers, typename Ready>
+void BenchLoop(bench::Reporter& report, std::string_view name) {
+    using Loop = BasicEventLoop<Selector, Timers, Ready>;
+    report.Add(fmt::format("ready <{}>", name), BenchReady<Loop>(), "M dispatch/s");
+    report.Add(fmt::format("timers <{}>", name), BenchTimers<Loop>(), "M timer/s");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_event_loop", argc, argv};
+
+    // 4096 个连接需要 8192 个 fd
+    rlimit limit{};
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+
+    report.Section("BasicEventLoop<Selector, Timer, Ready>");
+    BenchLoop<EpollSelector, HeapTimerQueue, DequeReadyQueue>(report, "Epoll, Heap, Deque (default)");
+    BenchLoop<EpollSelector, HeapTimerQueue, RingReadyQueue>(report, "Epoll, Heap, Ring");
+    BenchLoop<EpollSelector, QuadHeapTimerQueue, DequeReadyQueue>(report, "Epoll, QuadHeap, Deque");
+    BenchLoop<EpollSelector, QuadHeapTimerQueue, RingReadyQueue>(report, "Epoll, QuadHeap, Ring");
+    BenchLoop<PollSelector, HeapTimerQueue, DequeReadyQueue>(report, "Poll, Heap, Deque");
+    BenchLoop<PollSelector, HeapTimerQueue, RingReadyQueue>(report, "Poll, Heap, Ring");
+    BenchLoop<PollSelector, QuadHeapTimerQueue, DequeReadyQueue>(report, "Poll, QuadHeap, Deque");
+    BenchLoop<PollSelector, QuadHeapTimerQueue, RingReadyQueue>(report, "Poll, QuadHeap, Ring");
+
+    report.Section("Select(0), 8 ready");
+    for (size_t connections : {8, 64, 1024, 4096}) {
+        report.Add(fmt::format("Select <Epoll> {} connections", connections),
+                   BenchSelect<EpollSelector>(connections), "us/op");
+        report.Add(fmt::format("Select <Poll> {} connections", connections),
+                   BenchSelect<PollSelector>(connections), "us/op");
+    }
+
+    report.Section("Clock::Now()");
+    report.Add("clock <Monotonic>", BenchClock<MonotonicClock>(), "ns/op");
+    report.Add("clock <CoarseMonotonic>", BenchClock<CoarseMonotonicClock>(), "ns/op");
+#if defined(__x86_64__) || defined(__i386__)
+    report.Add("clock <Tsc>", BenchClock<TscClock>(), "ns/op");
+#endif
+    return 0;
+}
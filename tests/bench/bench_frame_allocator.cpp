@@ -0,0 +1,60 @@
+// 协程帧分配: 全局 operator new 与按请求的内存池 (std::pmr::monotonic_buffer_resource) 对比
+// NOTE: 多个并发的请求处理协程交错执行, 分摊事件循环每轮的 Select 开销
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+#include <memory_resource>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+
+constexpr size_t kRequests = 200'000;
+constexpr size_t kWorkers = 1'000;
+constexpr size_t kCallsPerRequest = 8;  // 每个请求调用的子协程数
+
+Task<int> Step(int x) { co_return x + 1; }
+
+Task<int> Step(std::allocator_arg_t, std::pmr::polymorphic_allocator<>, int x) { co_return x + 1; }
+
+// 子协程帧从全局堆分配
+Task<> GlobalWorker() {
+    int sum = 0;
+    for (size_t i = 0; i < kRequests / kWorkers; ++i) {
+        for (size_t j = 0; j < kCallsPerRequest; ++j) {
+            sum = co_await Step(sum);
+        }
+    }
+}
+
+// 子协程帧从请求内存池分配, 请求结束时整体回收
+Task<> ArenaWorker() {
+    alignas(std::max_align_t) std::byte buffer[2048];
+    int sum = 0;
+    for (size_t i = 0; i < kRequests / kWorkers; ++i) {
+        std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer),
+                                                  std::pmr::null_memory_resource()};
+        for (size_t j = 0; j < kCallsPerRequest; ++j) {
+            sum = co_await Step(std::allocator_arg, &arena, sum);
+        }
+    }
+}
+
+template <typename Fn>
+void Bench(bench::Reporter& report, std::string_view name, Fn&& worker) {
+    auto start = std::chrono::steady_clock::now();
+    Run([&]() -> Task<> {
+        TaskGroup group;
+        for (size_t i = 0; i < kWorkers; ++i) {
+            group.Spawn(worker());
+        }
+        co_await group.Wait();
+    }());
+    report.Add(std::string{name}, bench::Seconds(start) / (kRequests * kCallsPerRequest) * 1e9, "ns/coroutine");
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_frame_allocator", argc, argv};
+    Bench(report, "global operator new", GlobalWorker);
+    Bench(report, "per-request pmr arena", ArenaWorker);
+    return 0;
+}
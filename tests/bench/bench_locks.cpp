@@ -0,0 +1,93 @@
+// 同步原语的竞争开销: 10k 个协程同时等待同一个同步原语
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+
+constexpr size_t kWaiters = 10'000;
+constexpr size_t kRounds = 10;
+
+// 持有锁期间的"工作": 经过一次就绪队列往返, 让其他协程有机会排队
+Task<> Work() { co_return; }
+
+template <typename Fn>
+void Bench(bench::Reporter& report, std::string_view name, size_t ops, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    Run(fn());
+    report.Add(std::string{name}, bench::Seconds(start) / ops * 1e9, "ns/op");
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_locks", argc, argv};
+    Bench(report, "AsyncMutex handoff", kWaiters * kRounds, []() -> Task<> {
+        AsyncMutex mutex;
+        size_t counter = 0;
+        auto worker = [&]() -> Task<> {
+            for (size_t i = 0; i < kRounds; ++i) {
+                auto guard = co_await mutex.ScopedLock();
+                ++counter;
+                co_await Work();
+            }
+        };
+        TaskGroup group;
+        for (size_t i = 0; i < kWaiters; ++i) {
+            group.Spawn(worker());
+        }
+        co_await group.Wait();
+    });
+
+    Bench(report, "AsyncSemaphore(64) handoff", kWaiters * kRounds, []() -> Task<> {
+        AsyncSemaphore sem{64};
+        auto worker = [&]() -> Task<> {
+            for (size_t i = 0; i < kRounds; ++i) {
+                co_await sem.Acquire();
+                co_await Work();
+                sem.Release();
+            }
+        };
+        TaskGroup group;
+        for (size_t i = 0; i < kWaiters; ++i) {
+            group.Spawn(worker());
+        }
+        co_await group.Wait();
+    });
+
+    Bench(report, "AsyncEvent broadcast", kWaiters, []() -> Task<> {
+        AsyncEvent event;
+        auto waiter = [&]() -> Task<> { co_await event.Wait(); };
+        auto setter = [&]() -> Task<> {
+            co_await Work();
+            event.Set();
+        };
+        TaskGroup group;
+        for (size_t i = 0; i < kWaiters; ++i) {
+            group.Spawn(waiter());
+        }
+        group.Spawn(setter());
+        co_await group.Wait();
+    });
+
+    Bench(report, "AsyncRWLock mixed (1/8 w)", kWaiters * kRounds, []() -> Task<> {
+        AsyncRWLock lock;
+        auto worker = [&](size_t id) -> Task<> {
+            for (size_t i = 0; i < kRounds; ++i) {
+                if (id % 8 == 0) {
+                    co_await lock.Lock();
+                    lock.Unlock();
+                } else {
+                    co_await lock.LockShared();
+                    co_await Work();
+                    lock.UnlockShared();
+                }
+            }
+        };
+        TaskGroup group;
+        for (size_t i = 0; i < kWaiters; ++i) {
+            group.Spawn(worker(i));
+        }
+        co_await group.Wait();
+    });
+    return 0;
+}
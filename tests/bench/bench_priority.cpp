@@ -0,0 +1,64 @@
+// 后台负载下高优先级任务的延迟: 高优先级协程周期性 Sleep, 测量唤醒晚了多久;
+// 后台协程反复执行一小段 CPU 计算后让出, 对比相同优先级 / LOW 优先级 / LOW 加时间片
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kSamples = 2'000;
+constexpr size_t kBackgroundTasks = 100;
+
+// 忙等一段时间 (模拟计算)
+void Spin(std::chrono::nanoseconds duration) {
+    for (auto end = Clock::now() + duration; Clock::now() < end;) {
+    }
+}
+
+Task<> Background(bool const& stop) {
+    while (!stop) {
+        Spin(10us);
+        co_await Sleep(0ms);
+    }
+}
+
+Task<> Ticker(LatencyHistogram& lateness, bool& stop) {
+    for (size_t i = 0; i < kSamples; ++i) {
+        auto expected = Clock::now() + 200us;
+        co_await Sleep(200us);
+        lateness.Record(Clock::now() - expected);
+    }
+    stop = true;
+}
+
+void Bench(bench::Reporter& report, std::string_view name, size_t background, Priority priority,
+           std::chrono::nanoseconds time_slice = 0ns) {
+    auto& loop = GetEventLoop();
+    loop.SetTimeSlice(time_slice);
+    LatencyHistogram lateness;
+    bool stop = false;
+    Run([&]() -> Task<> {
+        TaskGroup group;
+        for (size_t i = 0; i < background; ++i) {
+            group.Spawn(Background(stop), priority);
+        }
+        group.Spawn(Ticker(lateness, stop), Priority::HIGH);
+        co_await group.Wait();
+    }());
+    loop.SetTimeSlice(0ns);
+    report.Add(fmt::format("lateness p50 <{}>", name), lateness.ValueAtPercentile(50) / 1e3, "us");
+    report.Add(fmt::format("lateness p99 <{}>", name), lateness.ValueAtPercentile(99) / 1e3, "us");
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_priority", argc, argv};
+    Bench(report, "idle", 0, Priority::LOW);
+    Bench(report, "background HIGH", kBackgroundTasks, Priority::HIGH);
+    Bench(report, "background LOW", kBackgroundTasks, Priority::LOW);
+    Bench(report, "background LOW, slice 100us", kBackgroundTasks, Priority::LOW, 100us);
+    return 0;
+}
@@ -0,0 +1,59 @@
+// 协程恢复速率: 事件循环每秒分派的协程恢复次数 (就绪队列 -> 协程帧)
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+
+constexpr size_t kAwaits = 2'000'000;
+constexpr size_t kWorkers = 1'000;
+
+Task<> Work() { co_return; }
+
+// 每次 co_await 子任务经过两次就绪队列分派: 恢复子任务, 子任务结束后恢复父任务
+Task<> Chain(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        co_await Work();
+    }
+}
+
+Task<> Workers() {
+    TaskGroup group;
+    for (size_t i = 0; i < kWorkers; ++i) {
+        group.Spawn(Chain(kAwaits / kWorkers));
+    }
+    co_await group.Wait();
+}
+
+template <typename Fn>
+void Bench(bench::Reporter& report, std::string_view name, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    Run(fn());
+    report.Add(std::string{name}, 2 * kAwaits / bench::Seconds(start) / 1e6, "M resume/s");
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_resume", argc, argv};
+    Bench(report, "1 coroutine chain", [] { return Chain(kAwaits); });
+    Bench(report, "1000 interleaved chains", Workers);
+    // 开启事件循环指标统计的开销 (每个回调读一次时钟并记录直方图)
+    GetEventLoop().EnableMetrics();
+    Bench(report, "1000 interleaved chains (metrics)", Workers);
+    GetEventLoop().EnableMetrics(false);
+    // 开启跟踪的开销 (每次恢复记录 RESUME/SUSPEND, 另有 CREATE/SCHEDULE/FINAL_SUSPEND)
+    GetEventLoop().EnableTracing();
+    Bench(report, "1000 interleaved chains (tracing)", Workers);
+    GetEventLoop().DisableTracing();
+    // 开启慢回调检测与看门狗的开销 (每个回调读两次时钟并发布正在运行的回调)
+    GetEventLoop().EnableSlowCallbackCheck();
+    GetEventLoop().EnableWatchdog();
+    Bench(report, "1000 interleaved chains (debug)", Workers);
+    GetEventLoop().DisableSlowCallbackCheck();
+    GetEventLoop().DisableWatchdog();
+    // 开启任务统计的开销 (每个回调查找标签, 记录挂起的起点)
+    GetEventLoop().EnableTaskAccounting();
+    Bench(report, "1000 interleaved chains (accounting)", Workers);
+    GetEventLoop().DisableTaskAccounting();
+    return 0;
+}
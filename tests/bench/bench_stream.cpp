@@ -0,0 +1,85 @@
+// 本机回环 TCP 流: 单连接吞吐量, 以及 ping-pong 往返延迟的分布 (服务端与客户端在同一个事件循环上)
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+
+constexpr uint16_t kPort = 8990;
+constexpr size_t kChunk = 64 * 1024;
+constexpr size_t kBytes = 512 * 1024 * 1024;
+constexpr size_t kRoundTrips = 50'000;
+
+// 吞吐量: 收满 kBytes 后回复 1 字节
+Task<> Sink(Stream stream) {
+    size_t total = 0;
+    while (total < kBytes) {
+        auto data = co_await stream.Read(kChunk);
+        if (data.empty()) {
+            co_return;
+        }
+        total += data.size();
+    }
+    co_await stream.Write(Stream::Buffer(1, 'k'));
+}
+
+// 延迟: 原样回显
+Task<> Echo(Stream stream) {
+    while (true) {
+        auto data = co_await stream.Read(kChunk);
+        if (data.empty()) {
+            co_return;
+        }
+        co_await stream.Write(data);
+    }
+}
+
+template <typename CB>
+Task<> Serve(CB cb) {
+    auto server = co_await StartServer(cb, "127.0.0.1", kPort);
+    co_await server.ServeForever();
+}
+
+Task<> Throughput(bench::Reporter& report) {
+    auto server = schedule_task(Serve(Sink));
+    auto stream = co_await OpenConnection("127.0.0.1", kPort);
+    Stream::Buffer chunk(kChunk, 'x');
+    auto start = std::chrono::steady_clock::now();
+    for (size_t sent = 0; sent < kBytes; sent += kChunk) {
+        co_await stream.Write(chunk);
+    }
+    co_await stream.Read(1);
+    report.Add(fmt::format("throughput ({} KiB writes)", kChunk / 1024),
+               kBytes / bench::Seconds(start) / (1024 * 1024), "MiB/s");
+    server.Cancel();
+}
+
+Task<> Latency(bench::Reporter& report, size_t size) {
+    auto server = schedule_task(Serve(Echo));
+    auto stream = co_await OpenConnection("127.0.0.1", kPort);
+    Stream::Buffer message(size, 'x');
+    LatencyHistogram histogram;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kRoundTrips; ++i) {
+        auto sent = std::chrono::steady_clock::now();
+        co_await stream.Write(message);
+        for (size_t received = 0; received < size;) {
+            received += (co_await stream.Read(size - received)).size();
+        }
+        histogram.Record(std::chrono::steady_clock::now() - sent);
+    }
+    auto name = fmt::format("ping-pong ({} B)", size);
+    report.Add(name, kRoundTrips / bench::Seconds(start) / 1e3, "K round trip/s");
+    report.Add(name + " p50", histogram.ValueAtPercentile(50) / 1e3, "us");
+    report.Add(name + " p99", histogram.ValueAtPercentile(99) / 1e3, "us");
+    server.Cancel();
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_stream", argc, argv};
+    Run(Throughput(report));
+    Run(Latency(report, 1));
+    Run(Latency(report, 4096));
+    return 0;
+}
@@ -0,0 +1,67 @@
+// 任务的基本开销: 创建 / co_await / 销毁, 以及 Gather 扇出 (每个子任务的平均耗时)
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+
+constexpr size_t kTasks = 2'000'000;
+constexpr size_t kFanOutTasks = 1'000'000;  // 扇出测试中子任务的总数
+
+Task<int> Work(int x) { co_return x + 1; }
+
+template <typename Fn>
+void Bench(bench::Reporter& report, std::string_view name, size_t count, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    Run(fn());
+    report.Add(std::string{name}, bench::Seconds(start) / count * 1e9, "ns/op");
+}
+
+// 每轮 GatherAll 一组 fan_out 个子任务
+Task<> FanOut(size_t fan_out) {
+    int sum = 0;
+    for (size_t round = 0; round < kFanOutTasks / fan_out; ++round) {
+        std::vector<Task<int>> tasks;
+        tasks.reserve(fan_out);
+        for (size_t i = 0; i < fan_out; ++i) {
+            tasks.push_back(Work(static_cast<int>(i)));
+        }
+        for (int value : co_await GatherAll(std::move(tasks))) {
+            sum += value;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_task", argc, argv};
+
+    // 协程帧分配 + 销毁 (不运行)
+    Bench(report, "create + destroy", kTasks, []() -> Task<> {
+        for (size_t i = 0; i < kTasks; ++i) {
+            auto task = Work(static_cast<int>(i));
+        }
+        co_return;
+    });
+    // 创建, 经事件循环运行子任务, 恢复父任务, 销毁
+    // NOTE: 只有一个协程时就绪队列每次分派后都为空, 包含每次迭代的 Select 开销 (对比 bench_resume)
+    Bench(report, "create + co_await + destroy", kTasks, []() -> Task<> {
+        int sum = 0;
+        for (size_t i = 0; i < kTasks; ++i) {
+            sum = co_await Work(sum);
+        }
+    });
+    Bench(report, "Gather(4 tasks)", kFanOutTasks, []() -> Task<> {
+        int sum = 0;
+        for (size_t i = 0; i < kFanOutTasks / 4; ++i) {
+            auto [a, b, c, d] = co_await Gather(Work(1), Work(2), Work(3), Work(4));
+            sum += a + b + c + d;
+        }
+    });
+    for (size_t fan_out : {10, 100, 1000}) {
+        Bench(report, fmt::format("GatherAll({} tasks) per task", fan_out), kFanOutTasks,
+              [fan_out] { return FanOut(fan_out); });
+    }
+    return 0;
+}
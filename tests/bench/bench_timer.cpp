@@ -0,0 +1,43 @@
+// 大量并发定时器: n 个协程同时 Sleep (插入 + 到期), 或同时 WaitFor 快速任务 (插入 + 取消)
+// NOTE: 原始定时器队列的插入/取消/到期见 bench_event_loop, 这里包含协程挂起与恢复的开销
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+#include <random>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+Task<int> Fast() { co_return 42; }
+
+Task<> Sleeper(std::chrono::microseconds delay) { co_await Sleep(delay); }
+
+Task<> Waiter() { co_await WaitFor(Fast(), 1h); }
+
+template <typename Fn>
+void Bench(bench::Reporter& report, std::string_view name, size_t count, Fn&& spawn) {
+    auto start = std::chrono::steady_clock::now();
+    Run([&]() -> Task<> {
+        TaskGroup group;
+        for (size_t i = 0; i < count; ++i) {
+            group.Spawn(spawn());
+        }
+        co_await group.Wait();
+    }());
+    report.Add(fmt::format("{} x{}", name, count), bench::Seconds(start) / count * 1e9, "ns/op");
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_timer", argc, argv};
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> delay{0, 9'999};
+    for (size_t count : {10'000, 100'000}) {
+        // 在 [0, 10ms) 内随机到期, 打乱定时器的插入顺序
+        // NOTE: 包含最后一个定时器到期前的等待 (< 10ms)
+        Bench(report, "Sleep (insert + fire)", count,
+              [&] { return Sleeper(std::chrono::microseconds(delay(rng))); });
+        Bench(report, "WaitFor (insert + cancel)", count, Waiter);
+    }
+    return 0;
+}
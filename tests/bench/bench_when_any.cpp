@@ -0,0 +1,52 @@
+// WhenAny 与 WaitFor 的开销对比: 快速任务与长超时 (Sleep) 竞速, 失败者立即被取消
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+#include <vector>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+constexpr size_t kIterations = 100'000;
+
+Task<int> Fast() { co_return 42; }
+
+Task<int> Slow() {
+    co_await Sleep(1h);
+    co_return 0;
+}
+
+template <typename Fn>
+void Bench(bench::Reporter& report, std::string_view name, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    Run(fn());
+    report.Add(std::string{name}, bench::Seconds(start) / kIterations * 1e9, "ns/op");
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_when_any", argc, argv};
+    Bench(report, "WaitFor", []() -> Task<> {
+        for (size_t i = 0; i < kIterations; ++i) {
+            co_await WaitFor(Fast(), 1h);
+        }
+    });
+
+    Bench(report, "WhenAny(fast, sleep)", []() -> Task<> {
+        for (size_t i = 0; i < kIterations; ++i) {
+            co_await WhenAny(Fast(), Sleep(1h));
+        }
+    });
+
+    Bench(report, "WhenAny(vector x4)", []() -> Task<> {
+        for (size_t i = 0; i < kIterations; ++i) {
+            std::vector<Task<int>> tasks;
+            tasks.push_back(Slow());
+            tasks.push_back(Slow());
+            tasks.push_back(Slow());
+            tasks.push_back(Fast());
+            co_await WhenAny(std::move(tasks));
+        }
+    });
+    return 0;
+}
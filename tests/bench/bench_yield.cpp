@@ -0,0 +1,67 @@
+// 操作预算 (EventLoop::SetOperationBudget): 一个一直有数据可处理的协程 (通道中的数据总是已就绪,
+// Recv 不挂起) 与周期性 Sleep 的协程共享事件循环, 测量后者被唤醒晚了多久
+#include <asyncio/asyncio.hpp>
+#include <chrono>
+
+#include "bench.hpp"
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kSamples = 2'000;
+constexpr int kBatch = 4096;
+
+// 忙等一段时间 (模拟处理一条数据)
+void Spin(std::chrono::nanoseconds duration) {
+    for (auto end = Clock::now() + duration; Clock::now() < end;) {
+    }
+}
+
+Task<> Hot(bool const& stop) {
+    Channel<int> channel;
+    while (!stop) {
+        for (int i = 0; i < kBatch; ++i) {
+            channel.TrySend(i);
+        }
+        for (int i = 0; i < kBatch; ++i) {
+            [[maybe_unused]] auto value = co_await channel.Recv();
+            Spin(100ns);
+        }
+        co_await Yield();
+    }
+}
+
+Task<> Ticker(LatencyHistogram& lateness, bool& stop) {
+    for (size_t i = 0; i < kSamples; ++i) {
+        auto expected = Clock::now() + 200us;
+        co_await Sleep(200us);
+        lateness.Record(Clock::now() - expected);
+    }
+    stop = true;
+}
+
+void Bench(bench::Reporter& report, std::string_view name, uint32_t budget) {
+    auto& loop = GetEventLoop();
+    loop.SetOperationBudget(budget);
+    LatencyHistogram lateness;
+    bool stop = false;
+    Run([&]() -> Task<> {
+        TaskGroup group;
+        group.Spawn(Hot(stop));
+        group.Spawn(Ticker(lateness, stop));
+        co_await group.Wait();
+    }());
+    loop.SetOperationBudget(ASYNCIO_OPERATION_BUDGET);
+    report.Add(fmt::format("lateness p50 <{}>", name), lateness.ValueAtPercentile(50) / 1e3, "us");
+    report.Add(fmt::format("lateness p99 <{}>", name), lateness.ValueAtPercentile(99) / 1e3, "us");
+}
+
+int main(int argc, char** argv) {
+    bench::Reporter report{"bench_yield", argc, argv};
+    Bench(report, "no budget", 0);
+    Bench(report, "budget 128", 128);
+    Bench(report, "budget 32", 32);
+    return 0;
+}
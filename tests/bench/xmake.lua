@@ -0,0 +1,83 @@
+target("bench_when_any", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_when_any.cpp")
+end)
+
+target("bench_locks", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_locks.cpp")
+end)
+
+target("bench_channel", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_channel.cpp")
+end)
+
+target("bench_error_path", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_error_path.cpp")
+end)
+
+target("bench_resume", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_resume.cpp")
+end)
+
+target("bench_event_loop", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_event_loop.cpp")
+end)
+
+target("bench_frame_allocator", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_frame_allocator.cpp")
+end)
+
+target("bench_context", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_context.cpp")
+end)
+
+target("bench_task", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_task.cpp")
+end)
+
+target("bench_timer", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_timer.cpp")
+end)
+
+target("bench_stream", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_stream.cpp")
+end)
+
+target("bench_busy_poll", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_busy_poll.cpp")
+end)
+
+target("bench_priority", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_priority.cpp")
+end)
+
+target("bench_yield", function()
+    set_kind("binary")
+    set_group("bench")
+    add_files("bench_yield.cpp")
+end)
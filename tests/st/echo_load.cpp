@@ -0,0 +1,247 @@
+// echo_server 的压测客户端: N 个并发连接, 输出吞吐量与延迟分位数
+// - 开环 (--rate > 0): 按固定速率发送, 延迟从计划发送时间算起 (修正协调遗漏: 服务端卡顿期间
+//   本该发出的请求也计入排队时间, 而不是等服务端恢复后才发出, 把卡顿藏起来)
+// - 闭环 (--rate 0): 每个连接保持 --pipeline 个未完成的请求, 收到响应后立即发送下一个
+//   NOTE: 闭环的延迟从实际发送时间算起, 不修正协调遗漏, 只适合测量最大吞吐量
+// 用法: echo_server --quiet & echo_load --connections 64 --rate 100000 --size 64 --duration 10
+#include <sys/resource.h>
+
+#include <asyncio/asyncio.hpp>
+#include <charconv>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "../bench/bench.hpp"
+
+using namespace asyncio;
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+    std::string host = "127.0.0.1";
+    uint16_t port = 9012;
+    size_t connections = 16;
+    double rate = 0;      // 所有连接合计的请求速率 (次/秒), 0 表示闭环
+    size_t pipeline = 1;  // 闭环时每个连接未完成的请求数
+    size_t size = 64;     // 请求大小 (字节)
+    double duration = 10;  // 统计时长 (秒)
+    double warmup = 1;     // 预热时长 (秒), 期间的请求不计入统计
+};
+
+// 统计区间 [begin, end) 内 (按计划发送时间) 的请求
+struct Stats {
+    Clock::time_point begin;
+    Clock::time_point end;
+    LatencyHistogram latency;
+    uint64_t responses{};
+
+    void Record(Clock::time_point sent, Clock::time_point received) {
+        if (sent >= begin && sent < end) {
+            latency.Record(received - sent);
+            ++responses;
+        }
+    }
+};
+
+void Usage() {
+    fmt::print(stderr,
+               "usage: echo_load [--host 127.0.0.1] [--port 9012] [--connections 16]\n"
+               "                 [--rate <requests/s, 0 = closed loop>] [--pipeline 1] [--size 64]\n"
+               "                 [--duration 10] [--warmup 1] [--json <file>]\n");
+}
+
+template <typename T>
+bool ParseNumber(std::string_view text, T& value) {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view name = argv[i];
+        if (i + 1 == argc) {
+            return false;
+        }
+        std::string_view value = argv[++i];
+        bool ok = true;
+        if (name == "--host") {
+            options.host = value;
+        } else if (name == "--port") {
+            ok = ParseNumber(value, options.port);
+        } else if (name == "--connections") {
+            ok = ParseNumber(value, options.connections) && options.connections > 0;
+        } else if (name == "--rate") {
+            ok = ParseNumber(value, options.rate) && options.rate >= 0;
+        } else if (name == "--pipeline") {
+            ok = ParseNumber(value, options.pipeline) && options.pipeline > 0;
+        } else if (name == "--size") {
+            ok = ParseNumber(value, options.size) && options.size > 0;
+        } else if (name == "--duration") {
+            ok = ParseNumber(value, options.duration) && options.duration > 0;
+        } else if (name == "--warmup") {
+            ok = ParseNumber(value, options.warmup) && options.warmup >= 0;
+        } else if (name != "--json") {  // --json 由 bench::Reporter 处理
+            ok = false;
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 读取回显: 按请求大小切分, 未收齐的部分留到下次
+struct EchoReader {
+    size_t size;
+    size_t partial{};  // 未收齐的响应已收到的字节数
+
+    // 返回本次收齐的响应数
+    Task<uint64_t> Read(Stream& stream) {
+        auto data = co_await stream.Read(64 * 1024);
+        if (data.empty()) {
+            throw std::runtime_error("connection closed by server");
+        }
+        partial += data.size();
+        uint64_t count = partial / size;
+        partial %= size;
+        co_return count;
+    }
+};
+
+// 开环: 按计划时间发送 (落后时一次发出所有到期的请求), 另一个协程接收
+Task<> OpenLoop(Stream& stream, Options const& options, Stats& stats, Clock::time_point first,
+                Clock::duration interval) {
+    std::deque<Clock::time_point> scheduled;  // 已发送请求的计划发送时间
+    uint64_t total = (stats.end - first + interval - Clock::duration{1}) / interval;
+
+    auto sender = [&]() -> Task<> {
+        Stream::Buffer buffer;
+        auto next = first;
+        while (next < stats.end) {
+            if (auto now = Clock::now(); now < next) {
+                co_await Sleep(next - now);
+            }
+            size_t due = 0;
+            for (auto now = Clock::now(); next <= now && next < stats.end; next += interval) {
+                scheduled.push_back(next);
+                ++due;
+            }
+            buffer.assign(due * options.size, 'x');
+            co_await stream.Write(buffer);
+        }
+    };
+    auto receiver = [&]() -> Task<> {
+        EchoReader reader{options.size};
+        while (total > 0) {
+            auto count = co_await reader.Read(stream);
+            auto now = Clock::now();
+            for (uint64_t i = 0; i < count; ++i) {
+                stats.Record(scheduled.front(), now);
+                scheduled.pop_front();
+            }
+            total -= count;
+        }
+    };
+    co_await Gather(sender(), receiver());
+}
+
+// 闭环: 每收到一个响应立即发送下一个请求, 直到统计区间结束
+Task<> ClosedLoop(Stream& stream, Options const& options, Stats& stats) {
+    std::deque<Clock::time_point> sent;  // 未完成请求的发送时间
+    Stream::Buffer buffer(options.size * options.pipeline, 'x');
+    sent.assign(options.pipeline, Clock::now());
+    co_await stream.Write(buffer);
+    EchoReader reader{options.size};
+    while (!sent.empty()) {
+        auto count = co_await reader.Read(stream);
+        auto now = Clock::now();
+        size_t next = 0;
+        for (uint64_t i = 0; i < count; ++i) {
+            stats.Record(sent.front(), now);
+            sent.pop_front();
+            if (now < stats.end) {
+                ++next;
+            }
+        }
+        if (next > 0) {
+            sent.insert(sent.end(), next, now);
+            buffer.assign(next * options.size, 'x');
+            co_await stream.Write(buffer);
+        }
+    }
+}
+
+Task<> Load(Options const& options, bench::Reporter& report) {
+    std::vector<Stream> streams;
+    streams.reserve(options.connections);
+    for (size_t i = 0; i < options.connections; ++i) {
+        streams.push_back(co_await OpenConnection(options.host, options.port));
+    }
+
+    auto start = Clock::now();
+    Stats stats;
+    stats.begin = start + std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double>(options.warmup));
+    stats.end = stats.begin + std::chrono::duration_cast<Clock::duration>(
+                                  std::chrono::duration<double>(options.duration));
+    TaskGroup group;
+    if (options.rate > 0) {
+        // 每个连接的发送间隔; 各连接错开相位, 合起来是均匀的请求流
+        auto interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(options.connections / options.rate));
+        interval = std::max(interval, Clock::duration{1});
+        for (size_t i = 0; i < options.connections; ++i) {
+            group.Spawn(OpenLoop(streams[i], options, stats, start + interval * i / options.connections,
+                                 interval));
+        }
+    } else {
+        for (auto& stream : streams) {
+            group.Spawn(ClosedLoop(stream, options, stats));
+        }
+    }
+    co_await group.Wait();
+
+    double seconds = std::chrono::duration<double>(stats.end - stats.begin).count();
+    auto& latency = stats.latency;
+    fmt::print("{} connections, {}, {} B requests, {:.1f}s (+{:.1f}s warmup)\n", options.connections,
+               options.rate > 0 ? fmt::format("open loop at {:.0f} req/s", options.rate)
+                                : fmt::format("closed loop, pipeline {}", options.pipeline),
+               options.size, options.duration, options.warmup);
+    report.Add("requests", stats.responses / seconds, "req/s");
+    report.Add("throughput", stats.responses * options.size / seconds / (1024 * 1024), "MiB/s");
+    report.Add("latency p50", latency.ValueAtPercentile(50) / 1e3, "us");
+    report.Add("latency p99", latency.ValueAtPercentile(99) / 1e3, "us");
+    report.Add("latency p999", latency.ValueAtPercentile(99.9) / 1e3, "us");
+    report.Add("latency max", latency.Max() / 1e3, "us");
+    if (options.rate > 0 && stats.responses < options.rate * seconds * 0.99) {
+        fmt::print(stderr, "warning: achieved rate is below the target, the server is saturated\n");
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        Usage();
+        return 1;
+    }
+    // 大量连接
+    rlimit limit{};
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+
+    bench::Reporter report{"echo_load", argc, argv};
+    try {
+        Run(Load(options, report));
+    } catch (std::exception const& e) {
+        fmt::print(stderr, "echo_load: {}\n", e.what());
+        return 1;
+    }
+    return 0;
+}
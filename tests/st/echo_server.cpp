@@ -1,11 +1,13 @@
 #include <arpa/inet.h>
 
 #include <asyncio/asyncio.hpp>
+#include <string_view>
 
 using namespace asyncio;
 
 int add_count = 0;
 int rel_count = 0;
+bool quiet = false;  // --quiet: 不输出每条消息 (配合 echo_load 压测)
 
 Task<> handle_echo(Stream stream) {
     auto sockinfo = stream.GetSockInfo();
@@ -13,23 +15,29 @@ Task<> handle_echo(Stream stream) {
     auto sa = reinterpret_cast<const sockaddr*>(&sockinfo);
 
     ++add_count;
-    fmt::print("connections: {}/{}\n", rel_count, add_count);
+    if (!quiet) {
+        fmt::print("connections: {}/{}\n", rel_count, add_count);
+    }
     while (true) {
         try {
-            auto data = co_await stream.Read(200);
+            auto data = co_await stream.Read(4096);
             if (data.empty()) {
                 break;
             }
-            fmt::print("Received: '{}' from '{}:{}'\n", data.data(),
-                       inet_ntop(sockinfo.ss_family, GetInAddr(sa), addr, sizeof addr),
-                       GetInPort(sa));
+            if (!quiet) {
+                fmt::print("Received: '{}' from '{}:{}'\n", data.data(),
+                           inet_ntop(sockinfo.ss_family, GetInAddr(sa), addr, sizeof addr),
+                           GetInPort(sa));
+            }
             co_await stream.Write(data);
         } catch (...) {
             break;
         }
     }
     ++rel_count;
-    fmt::print("connections: {}/{}\n", rel_count, add_count);
+    if (!quiet) {
+        fmt::print("connections: {}/{}\n", rel_count, add_count);
+    }
     stream.Close();
 }
 
@@ -41,7 +49,8 @@ Task<> echo_server() {
     co_await server.ServeForever();
 }
 
-int main() {
+int main(int argc, char** argv) {
+    quiet = argc > 1 && std::string_view{argv[1]} == "--quiet";
     Run(echo_server());
     return 0;
 }
@@ -17,3 +17,8 @@ target("echo_server", function()
     set_kind("binary")
     add_files("echo_server.cpp")
 end)
+
+target("echo_load", function()
+    set_kind("binary")
+    add_files("echo_load.cpp")
+end)
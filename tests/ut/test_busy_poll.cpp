@@ -0,0 +1,114 @@
+#include <sys/socket.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+#include <thread>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+SCENARIO("test adaptive busy poll window") {
+    detail::BusyPollWindow window;
+    REQUIRE(!window.Enabled());
+
+    GIVEN("fixed window") {
+        window.Configure(50us, false);
+        REQUIRE(window.Enabled());
+        REQUIRE(window.Window() == 50us);
+        window.OnBlocked(10ms, true);
+        REQUIRE(window.Window() == 50us);
+    }
+
+    GIVEN("adaptive window") {
+        window.Configure(80us, true);
+        REQUIRE(window.Window() == 10us);
+        // 阻塞后很快有事件: 翻倍直到最大窗口
+        window.OnBlocked(30us, true);
+        REQUIRE(window.Window() == 20us);
+        window.OnBlocked(30us, true);
+        window.OnBlocked(30us, true);
+        window.OnBlocked(30us, true);
+        REQUIRE(window.Window() == 80us);
+        // 定时器超时不说明事件的到达间隔
+        window.OnBlocked(30us, false);
+        REQUIRE(window.Window() == 80us);
+        // 事件稀疏: 减半直到不再轮询
+        for (int i = 0; i < 10; ++i) {
+            window.OnBlocked(1ms, true);
+        }
+        REQUIRE(window.Window() == 0us);
+        REQUIRE(window.Enabled());
+        // 事件再次密集时恢复轮询
+        window.OnBlocked(30us, true);
+        REQUIRE(window.Window() == 10us);
+    }
+}
+
+SCENARIO("test event loop busy poll") {
+    auto& loop = GetEventLoop();
+    int fds[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+
+    GIVEN("timers still fire on time while polling") {
+        loop.EnableBusyPoll(200us, false);
+        auto start = std::chrono::steady_clock::now();
+        Run([]() -> Task<> {
+            for (int i = 0; i < 10; ++i) {
+                co_await Sleep(500us);
+            }
+        }());
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        REQUIRE(elapsed >= 5ms);
+        REQUIRE(elapsed < 500ms);
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+#if ASYNCIO_ENABLE_LOOP_METRICS
+    GIVEN("an event that arrives inside the window is caught without blocking") {
+        // 窗口远大于写入延迟: 轮询中等到事件
+        loop.EnableBusyPoll(2s, false);
+        loop.ResetMetrics();
+        loop.EnableMetrics();
+        std::thread writer{[peer_fd = fds[1]] {
+            std::this_thread::sleep_for(5ms);
+            [[maybe_unused]] auto written = ::write(peer_fd, "x", 1);
+        }};
+        Run([local_fd = fds[0]]() -> Task<> {
+            Stream local{local_fd};
+            auto data = co_await local.Read(1);
+            REQUIRE(data.size() == 1);
+        }());
+        writer.join();
+        loop.EnableMetrics(false);
+        REQUIRE(loop.Metrics().busy_poll_hits >= 1);
+        REQUIRE(loop.Metrics().busy_poll_misses == 0);
+        ::close(fds[1]);
+    }
+
+    GIVEN("an empty window falls back to blocking") {
+        loop.EnableBusyPoll(100us, false);
+        loop.ResetMetrics();
+        loop.EnableMetrics();
+        Run([]() -> Task<> { co_await Sleep(5ms); }());
+        loop.EnableMetrics(false);
+        REQUIRE(loop.Metrics().busy_poll_misses >= 1);
+        // 阻塞等待而不是一直轮询到定时器到期
+        REQUIRE(loop.Metrics().iterations < 10);
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+#endif
+
+    GIVEN("SO_BUSY_POLL on a socket") {
+        Run([local_fd = fds[0], peer_fd = fds[1]]() -> Task<> {
+            Stream local{local_fd}, peer{peer_fd};
+            REQUIRE(local.SetBusyPoll(0us).IsOk());
+            co_return;
+        }());
+        REQUIRE(socket::SetBusyPoll(-1, 50us).Error() == std::errc::bad_file_descriptor);
+    }
+
+    loop.DisableBusyPoll();
+    REQUIRE(!loop.IsBusyPollEnabled());
+}
@@ -0,0 +1,152 @@
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <numeric>
+#include <asyncio/asyncio.hpp>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+SCENARIO("test Channel") {
+    GIVEN("bounded channel suspends full sender") {
+        Channel<int> channel{2};
+        std::vector<int> sent;
+        std::vector<int> received;
+        auto producer = [&]() -> Task<> {
+            for (int i = 0; i < 10; ++i) {
+                co_await channel.Send(i);
+                sent.push_back(i);
+                REQUIRE(channel.Size() <= 2);
+            }
+            channel.Close();
+        };
+        auto consumer = [&]() -> Task<> {
+            co_await Sleep(5ms);
+            REQUIRE(sent.size() == 2);  // 缓冲区已满, 发送者挂起
+            while (auto value = co_await channel.Recv()) {
+                received.push_back(*value);
+            }
+        };
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            group.Spawn(producer());
+            group.Spawn(consumer());
+            co_await group.Wait();
+        }());
+        REQUIRE(received == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    }
+
+    GIVEN("send to closed channel throws, recv drains then returns nullopt") {
+        Channel<std::string> channel;
+        Run([&]() -> Task<> {
+            co_await channel.Send("a");
+            co_await channel.Send("b");
+            channel.Close();
+            REQUIRE_THROWS_AS(co_await channel.Send("c"), ChannelClosedError);
+            auto a = co_await channel.Recv();
+            auto b = co_await channel.Recv();
+            auto end = co_await channel.Recv();
+            REQUIRE(a == "a");
+            REQUIRE(b == "b");
+            REQUIRE(!end.has_value());
+        }());
+    }
+
+    GIVEN("close wakes suspended receivers") {
+        Channel<int> channel{1};
+        int closed = 0;
+        auto receiver = [&]() -> Task<> {
+            if (!co_await channel.Recv()) {
+                ++closed;
+            }
+        };
+        auto closer = [&]() -> Task<> {
+            co_await Sleep(1ms);
+            channel.Close();
+        };
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            group.Spawn(receiver());
+            group.Spawn(receiver());
+            group.Spawn(closer());
+            co_await group.Wait();
+        }());
+        REQUIRE(closed == 2);
+    }
+
+    GIVEN("RecvMany drains many items per wakeup") {
+        Channel<int> channel{64};
+        std::vector<size_t> batches;
+        auto consumer = [&]() -> Task<> {
+            std::array<int, 16> buffer{};
+            while (size_t n = co_await channel.RecvMany(buffer)) {
+                batches.push_back(n);
+            }
+        };
+        auto producer = [&]() -> Task<> {
+            for (int i = 0; i < 40; ++i) {
+                co_await channel.Send(i);  // 未挂起: 接收者被唤醒前数据已进入缓冲区
+            }
+            channel.Close();
+        };
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            group.Spawn(consumer());
+            group.Spawn(producer());
+            co_await group.Wait();
+        }());
+        REQUIRE(std::accumulate(batches.begin(), batches.end(), size_t{0}) == 40);
+        REQUIRE(batches.size() <= 4);
+    }
+
+    GIVEN("cancelled receiver leaves the channel") {
+        Channel<int> channel;
+        bool cancelled = false;
+        auto receiver = [&]() -> Task<> {
+            try {
+                co_await channel.Recv();
+            } catch (CancelledError const&) {
+                cancelled = true;
+            }
+        };
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            group.Spawn(receiver());
+            co_await Sleep(1ms);
+            group.Cancel();
+            co_await group.Wait();
+            co_await channel.Send(1);  // 不会交给已取消的接收者
+        }());
+        REQUIRE(cancelled);
+        REQUIRE(channel.Size() == 1);
+    }
+}
+
+SCENARIO("test SpscChannel") {
+    SpscChannel<int> channel{3};
+    REQUIRE(channel.Capacity() == 4);
+    long sum = 0;
+    size_t received = 0;
+    auto producer = [&]() -> Task<> {
+        for (int i = 0; i < 1000; ++i) {
+            co_await channel.Send(i);
+        }
+        channel.Close();
+    };
+    auto consumer = [&]() -> Task<> {
+        std::array<int, 3> buffer{};
+        while (size_t n = co_await channel.RecvMany(buffer)) {
+            for (size_t i = 0; i < n; ++i) {
+                REQUIRE(buffer[i] == static_cast<int>(received++));
+                sum += buffer[i];
+            }
+        }
+    };
+    Run([&]() -> Task<> {
+        TaskGroup group;
+        group.Spawn(producer());
+        group.Spawn(consumer());
+        co_await group.Wait();
+    }());
+    REQUIRE(received == 1000);
+    REQUIRE(sum == 999 * 1000 / 2);
+}
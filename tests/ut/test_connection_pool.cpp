@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+namespace {
+
+// 回显一次后, 按 close_after_echo 决定是否主动关闭连接
+Task<> echo_server(uint16_t port, bool close_after_echo) {
+    auto handle_echo = [close_after_echo](Stream stream) -> Task<> {
+        while (true) {
+            auto data = co_await stream.Read(100);
+            if (data.empty()) {
+                break;
+            }
+            co_await stream.Write(data);
+            if (close_after_echo) {
+                break;
+            }
+        }
+        stream.Close();
+    };
+    auto server = co_await StartServer(handle_echo, "127.0.0.1", port);
+    co_await server.ServeForever();
+}
+
+Task<> echo_once(PooledStream& conn, std::string_view message) {
+    co_await conn->Write(Stream::Buffer(message.begin(), message.end()));
+    auto data = co_await conn->Read(100);
+    REQUIRE(std::string_view{data.data(), data.size()} == message);
+}
+
+}  // namespace
+
+SCENARIO("test ConnectionPool") {
+    GIVEN("reuse released connection") {
+        Run([&]() -> Task<> {
+            auto srv = schedule_task(echo_server(8891, false));
+            ConnectionPool pool;
+            {
+                auto conn = co_await pool.Acquire("127.0.0.1", 8891);
+                co_await echo_once(conn, "first");
+            }
+            REQUIRE(pool.IdleCount() == 1);
+            {
+                auto conn = co_await pool.Acquire("127.0.0.1", 8891);
+                REQUIRE(pool.IdleCount() == 0);
+                co_await echo_once(conn, "second");
+            }
+            auto& stats = pool.GetStats();
+            REQUIRE(stats.misses == 1);
+            REQUIRE(stats.hits == 1);
+            srv.Cancel();
+        }());
+    }
+
+    GIVEN("per host limit queues waiters in FIFO order") {
+        Run([&]() -> Task<> {
+            auto srv = schedule_task(echo_server(8892, false));
+            ConnectionPool pool{{.max_per_host = 1}};
+            std::vector<int> order;
+            auto client = [&](int id) -> Task<> {
+                auto conn = co_await pool.Acquire("127.0.0.1", 8892);
+                order.push_back(id);
+                co_await echo_once(conn, "ping");
+            };
+            auto c0 = schedule_task(client(0));
+            auto c1 = schedule_task(client(1));
+            auto c2 = schedule_task(client(2));
+            co_await c0;
+            co_await c1;
+            co_await c2;
+            REQUIRE(order == std::vector<int>{0, 1, 2});
+            auto& stats = pool.GetStats();
+            REQUIRE(stats.misses == 1);
+            REQUIRE(stats.hits == 2);
+            REQUIRE(stats.waits == 2);
+            srv.Cancel();
+        }());
+    }
+
+    GIVEN("a granted waiter destroyed before it resumes gives the grant back") {
+        Run([&]() -> Task<> {
+            auto srv = schedule_task(echo_server(8895, false));
+            ConnectionPool pool{{.max_per_host = 1}};
+            auto acquire = [&]() -> Task<> { co_await pool.Acquire("127.0.0.1", 8895); };
+            // 移交的连接: 放回空闲队列
+            {
+                auto conn = co_await pool.Acquire("127.0.0.1", 8895);
+                co_await echo_once(conn, "first");
+                auto waiter = schedule_task(acquire());
+                co_await Sleep(1ms);  // 排队
+                conn.Release();       // 移交给排队者, 排队者尚未恢复
+                waiter.Cancel();
+            }
+            REQUIRE(pool.IdleCount() == 1);
+            // 新建连接的名额: 释放, 之后的借出不会一直排队
+            {
+                auto conn = co_await pool.Acquire("127.0.0.1", 8895);
+                auto waiter = schedule_task(acquire());
+                co_await Sleep(1ms);
+                conn.MarkBroken();
+                conn.Release();
+                waiter.Cancel();
+            }
+            auto reuse = [&]() -> Task<> {
+                auto conn = co_await pool.Acquire("127.0.0.1", 8895);
+                co_await echo_once(conn, "second");
+            };
+            co_await WaitFor(reuse(), 1s);
+            auto& stats = pool.GetStats();
+            REQUIRE(stats.waits == 2);
+            REQUIRE(stats.misses == 2);
+            srv.Cancel();
+        }());
+    }
+
+    GIVEN("discard stale idle connection") {
+        Run([&]() -> Task<> {
+            auto srv = schedule_task(echo_server(8893, true));
+            ConnectionPool pool;
+            {
+                auto conn = co_await pool.Acquire("127.0.0.1", 8893);
+                co_await echo_once(conn, "first");
+            }
+            co_await Sleep(20ms);  // 等待服务端关闭连接
+            {
+                auto conn = co_await pool.Acquire("127.0.0.1", 8893);
+                co_await echo_once(conn, "second");
+            }
+            auto& stats = pool.GetStats();
+            REQUIRE(stats.misses == 2);
+            REQUIRE(stats.hits == 0);
+            srv.Cancel();
+        }());
+    }
+
+    GIVEN("evict idle connection") {
+        Run([&]() -> Task<> {
+            auto srv = schedule_task(echo_server(8894, false));
+            ConnectionPool pool{{.idle_timeout = 20ms}};
+            {
+                auto conn = co_await pool.Acquire("127.0.0.1", 8894);
+                co_await echo_once(conn, "first");
+            }
+            REQUIRE(pool.IdleCount() == 1);
+            co_await Sleep(50ms);
+            REQUIRE(pool.IdleCount() == 0);
+            REQUIRE(pool.GetStats().evictions == 1);
+            srv.Cancel();
+        }());
+    }
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+namespace {
+
+ContextVar<std::string> trace_id;
+ContextVar<int> tenant;
+
+// 睡眠后读取 trace id (期间其他协程可能修改自己的上下文)
+Task<std::string> ReadTraceAfter(std::chrono::milliseconds delay) {
+    co_await Sleep(delay);
+    co_return trace_id.ValueOr("none");
+}
+
+Task<> SetTrace(std::string id) {
+    trace_id.Set(std::move(id));
+    co_return;
+}
+
+// 模拟一个请求: 设置 trace id 后经过多层子协程读取
+Task<std::string> Request(std::string id, std::chrono::milliseconds delay) {
+    trace_id.Set(id);
+    co_await Sleep(delay);
+    co_return co_await ReadTraceAfter(delay);
+}
+
+}  // namespace
+
+SCENARIO("test ContextVar") {
+    GIVEN("unset variable") {
+        Run([]() -> Task<> {
+            REQUIRE(trace_id.Get() == nullptr);
+            REQUIRE(tenant.ValueOr(-1) == -1);
+            tenant.Reset();  // 清除未设置的变量
+            REQUIRE(tenant.Get() == nullptr);
+            co_return;
+        }());
+    }
+
+    GIVEN("child inherits parent context across co_await") {
+        Run([]() -> Task<> {
+            trace_id.Set("req-1");
+            tenant.Set(42);
+            REQUIRE(co_await ReadTraceAfter(1ms) == "req-1");
+            REQUIRE(*tenant.Get() == 42);
+        }());
+    }
+
+    GIVEN("child modification is copy-on-write") {
+        Run([]() -> Task<> {
+            trace_id.Set("parent");
+            co_await SetTrace("child");
+            REQUIRE(*trace_id.Get() == "parent");
+            trace_id.Reset();
+            REQUIRE(trace_id.Get() == nullptr);
+        }());
+    }
+
+    GIVEN("created child keeps the snapshot taken at creation") {
+        Run([]() -> Task<> {
+            trace_id.Set("before");
+            auto child = ReadTraceAfter(1ms);
+            trace_id.Set("after");
+            auto seen = co_await std::move(child);
+            REQUIRE(seen == "before");
+            REQUIRE(*trace_id.Get() == "after");
+        }());
+    }
+
+    GIVEN("concurrent requests are isolated") {
+        Run([]() -> Task<> {
+            auto [a, b, c] = co_await Gather(Request("a", 3ms), Request("b", 1ms), Request("c", 2ms));
+            REQUIRE(a == "a");
+            REQUIRE(b == "b");
+            REQUIRE(c == "c");
+            REQUIRE(trace_id.Get() == nullptr);
+        }());
+    }
+
+    GIVEN("Gather and TaskGroup children inherit") {
+        Run([]() -> Task<> {
+            trace_id.Set("group");
+            auto [a, b] = co_await Gather(ReadTraceAfter(1ms), ReadTraceAfter(2ms));
+            REQUIRE(a == "group");
+            REQUIRE(b == "group");
+            std::vector<std::string> seen;
+            TaskGroup group;
+            for (int i = 0; i < 3; ++i) {
+                group.Spawn([](std::vector<std::string>& seen) -> Task<> {
+                    seen.push_back(co_await ReadTraceAfter(1ms));
+                }(seen));
+            }
+            co_await group.Wait();
+            REQUIRE(seen == std::vector<std::string>(3, "group"));
+        }());
+    }
+
+    GIVEN("root context outside coroutines") {
+        tenant.Set(7);
+        Run([]() -> Task<> {
+            REQUIRE(*tenant.Get() == 7);
+            tenant.Set(8);
+            co_return;
+        }());
+        REQUIRE(*tenant.Get() == 7);
+        tenant.Reset();
+        REQUIRE(tenant.Get() == nullptr);
+    }
+}
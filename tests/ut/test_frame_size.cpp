@@ -0,0 +1,94 @@
+// 协程 promise 与协程帧大小预算
+// NOTE: 按构建配置分别检查 (debug: 保存源码位置, release/NDEBUG: 不保存), 见 ASYNCIO_ENABLE_FRAME_INFO
+// 预算是当前的大小 (GCC, x86-64), 超出即失败; 确实需要增大时同步修改这里和 README 的表格
+#include <coroutine>
+#include <cstddef>
+#include <new>
+
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+
+using namespace asyncio;
+
+namespace {
+
+#if ASYNCIO_ENABLE_FRAME_INFO
+constexpr size_t kPromiseBudget = 88;
+constexpr size_t kTaskFrameBudget = 120;
+constexpr size_t kGeneratorPromiseBudget = 72;
+#else
+constexpr size_t kPromiseBudget = 80;
+constexpr size_t kTaskFrameBudget = 112;
+constexpr size_t kGeneratorPromiseBudget = 64;
+#endif
+
+size_t last_frame_size = 0;  // 最近一次创建的探测协程的帧大小
+
+// 探测参数: 空类型, 不增大协程帧
+struct FrameProbe {};
+
+// 记录帧大小的 promise, 帧仍从全局 operator new 分配
+// NOTE: 不增加数据成员, 帧大小与 PromiseType<R> 的协程相同
+template <typename R>
+struct ProbePromise : PromiseType<R> {
+    auto get_return_object() noexcept {
+        return this->MakeTask(std::coroutine_handle<ProbePromise>::from_promise(*this));
+    }
+
+    static void* operator new(size_t size, FrameProbe) {
+        last_frame_size = size;
+        return ::operator new(size);
+    }
+
+    static void operator delete(void* ptr, size_t size) noexcept { ::operator delete(ptr, size); }
+};
+
+}  // namespace
+
+// 参数为 (FrameProbe) 的协程使用 ProbePromise, 其余协程不受影响
+template <typename R>
+struct std::coroutine_traits<Task<R>, FrameProbe> {
+    using promise_type = ProbePromise<R>;
+};
+
+namespace {
+
+Task<> Empty(FrameProbe) { co_return; }
+
+Task<int> Value(FrameProbe) { co_return 1; }
+
+// 创建 (不运行) 一个协程并返回其帧大小
+template <typename Fn>
+size_t FrameSize(Fn&& fn) {
+    last_frame_size = 0;
+    auto coro = fn(FrameProbe{});
+    return last_frame_size;
+}
+
+}  // namespace
+
+// 句柄 ID, 协程标记与状态打包在一个字
+static_assert(sizeof(Handle) <= 16);
+// Handle + 取消令牌 + 协程帧地址 + 上下文
+static_assert(sizeof(CoroHandle) <= 40);
+// void 结果只占一个 variant
+static_assert(sizeof(Result<void>) <= 24);
+static_assert(sizeof(Result<int>) <= 24);
+
+static_assert(sizeof(PromiseType<void>) <= kPromiseBudget);
+static_assert(sizeof(PromiseType<int>) <= kPromiseBudget);
+static_assert(sizeof(AsyncGenerator<int>::promise_type) <= kGeneratorPromiseBudget);
+
+SCENARIO("promise and frame sizes stay within budget") {
+    GIVEN("Task<> with an empty body") {
+        size_t size = FrameSize(Empty);
+        REQUIRE(size > 0);
+        REQUIRE(size <= kTaskFrameBudget);
+    }
+
+    GIVEN("Task<int> returning a value") {
+        size_t size = FrameSize(Value);
+        REQUIRE(size > 0);
+        REQUIRE(size <= kTaskFrameBudget);
+    }
+}
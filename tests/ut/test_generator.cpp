@@ -0,0 +1,94 @@
+#include <sys/socket.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+namespace {
+
+AsyncGenerator<int> Range(int n, int& produced) {
+    for (int i = 0; i < n; ++i) {
+        ++produced;
+        co_yield i;
+    }
+}
+
+AsyncGenerator<std::string> Failing() {
+    co_yield "ok";
+    co_await Sleep(1ms);
+    throw std::runtime_error("producer failed");
+}
+
+}  // namespace
+
+SCENARIO("test AsyncGenerator") {
+    GIVEN("pull values with Next()") {
+        int produced = 0;
+        Run([&]() -> Task<> {
+            auto gen = Range(5, produced);
+            REQUIRE(produced == 0);  // 惰性启动
+            std::vector<int> values;
+            while (auto value = co_await gen.Next()) {
+                REQUIRE(produced == *value + 1);  // 背压: 生产者只领先一个值
+                values.push_back(*value);
+            }
+            REQUIRE(values == std::vector<int>{0, 1, 2, 3, 4});
+        }());
+    }
+
+    GIVEN("iterate with begin/end") {
+        int produced = 0;
+        int sum = 0;
+        Run([&]() -> Task<> {
+            auto gen = Range(10, produced);
+            for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) {
+                sum += *it;
+            }
+        }());
+        REQUIRE(sum == 45);
+    }
+
+    GIVEN("producer exception is rethrown by consumer") {
+        std::vector<std::string> values;
+        REQUIRE_THROWS_AS(Run([&]() -> Task<> {
+                              auto gen = Failing();
+                              while (auto value = co_await gen.Next()) {
+                                  values.push_back(*value);
+                              }
+                          }()),
+                          std::runtime_error);
+        REQUIRE(values == std::vector<std::string>{"ok"});
+    }
+
+    GIVEN("consumer stops early") {
+        int produced = 0;
+        Run([&]() -> Task<> {
+            auto gen = Range(1000, produced);
+            co_await gen.Next();
+            co_await gen.Next();
+        }());
+        REQUIRE(produced == 2);
+    }
+
+    GIVEN("Stream::Chunks reads until eof") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+        std::string payload(10000, 'x');
+        REQUIRE(::write(fds[1], payload.data(), payload.size()) == 10000);
+        ::close(fds[1]);
+        size_t total = 0;
+        size_t max_chunk = 0;
+        Run([&]() -> Task<> {
+            Stream stream{fds[0]};
+            auto chunks = stream.Chunks(4096);
+            while (auto chunk = co_await chunks.Next()) {
+                total += chunk->size();
+                max_chunk = std::max(max_chunk, chunk->size());
+            }
+        }());
+        REQUIRE(total == 10000);
+        REQUIRE(max_chunk <= 4096);
+    }
+}
@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+SCENARIO("test AsyncMutex") {
+    GIVEN("critical section is exclusive and FIFO") {
+        AsyncMutex mutex;
+        int inside = 0;
+        std::vector<int> order;
+        auto worker = [&](int id) -> Task<> {
+            auto guard = co_await mutex.ScopedLock();
+            REQUIRE(++inside == 1);
+            order.push_back(id);
+            co_await Sleep(1ms);
+            --inside;
+        };
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            for (int i = 0; i < 5; ++i) {
+                group.Spawn(worker(i));
+            }
+            co_await group.Wait();
+        }());
+        REQUIRE(order == std::vector<int>{0, 1, 2, 3, 4});
+        REQUIRE(!mutex.IsLocked());
+    }
+
+    GIVEN("cancelled waiter leaves the queue") {
+        AsyncMutex mutex;
+        bool cancelled = false;
+        auto holder = [&]() -> Task<> {
+            co_await mutex.Lock();
+            co_await Sleep(20ms);
+            mutex.Unlock();
+        };
+        auto waiter = [&]() -> Task<> {
+            try {
+                co_await mutex.Lock();
+            } catch (CancelledError const&) {
+                cancelled = true;
+            }
+        };
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            group.Spawn(holder());
+            co_await Sleep(1ms);
+            TaskGroup waiters;
+            waiters.Spawn(waiter());
+            co_await Sleep(1ms);
+            waiters.Cancel();
+            co_await waiters.Wait();
+            co_await group.Wait();
+        }());
+        REQUIRE(cancelled);
+        REQUIRE(!mutex.IsLocked());
+    }
+}
+
+SCENARIO("test AsyncSemaphore") {
+    AsyncSemaphore sem{3};
+    size_t in_flight = 0;
+    size_t max_in_flight = 0;
+    auto worker = [&]() -> Task<> {
+        co_await sem.Acquire();
+        max_in_flight = std::max(max_in_flight, ++in_flight);
+        co_await Sleep(1ms);
+        --in_flight;
+        sem.Release();
+    };
+    Run([&]() -> Task<> {
+        TaskGroup group;
+        for (int i = 0; i < 20; ++i) {
+            group.Spawn(worker());
+        }
+        co_await group.Wait();
+    }());
+    REQUIRE(max_in_flight == 3);
+    REQUIRE(sem.Value() == 3);
+}
+
+SCENARIO("test AsyncEvent") {
+    AsyncEvent event;
+    int woken = 0;
+    auto waiter = [&]() -> Task<> {
+        co_await event.Wait();
+        ++woken;
+    };
+    auto setter = [&]() -> Task<> {
+        co_await Sleep(5ms);
+        REQUIRE(woken == 0);
+        event.Set();
+    };
+    Run([&]() -> Task<> {
+        TaskGroup group;
+        for (int i = 0; i < 10; ++i) {
+            group.Spawn(waiter());
+        }
+        group.Spawn(setter());
+        co_await group.Wait();
+        co_await event.Wait();  // 已设置: 立即返回
+    }());
+    REQUIRE(woken == 10);
+}
+
+SCENARIO("test AsyncCondition") {
+    AsyncMutex mutex;
+    AsyncCondition cond{mutex};
+    std::deque<int> queue;
+    std::vector<int> consumed;
+    auto consumer = [&]() -> Task<> {
+        for (int i = 0; i < 5; ++i) {
+            auto guard = co_await mutex.ScopedLock();
+            co_await cond.Wait([&] { return !queue.empty(); });
+            REQUIRE(mutex.IsLocked());
+            consumed.push_back(queue.front());
+            queue.pop_front();
+        }
+    };
+    auto producer = [&]() -> Task<> {
+        for (int i = 0; i < 5; ++i) {
+            co_await Sleep(1ms);
+            auto guard = co_await mutex.ScopedLock();
+            queue.push_back(i);
+            cond.Notify();
+        }
+    };
+    Run([&]() -> Task<> {
+        TaskGroup group;
+        group.Spawn(consumer());
+        group.Spawn(producer());
+        co_await group.Wait();
+    }());
+    REQUIRE(consumed == std::vector<int>{0, 1, 2, 3, 4});
+    REQUIRE(!mutex.IsLocked());
+}
+
+SCENARIO("test AsyncRWLock") {
+    AsyncRWLock lock;
+    int readers = 0;
+    int max_readers = 0;
+    bool writing = false;
+    std::vector<char> order;
+    auto reader = [&]() -> Task<> {
+        co_await lock.LockShared();
+        REQUIRE(!writing);
+        max_readers = std::max(max_readers, ++readers);
+        order.push_back('r');
+        co_await Sleep(2ms);
+        --readers;
+        lock.UnlockShared();
+    };
+    auto writer = [&]() -> Task<> {
+        co_await lock.Lock();
+        REQUIRE(readers == 0);
+        writing = true;
+        order.push_back('w');
+        co_await Sleep(2ms);
+        writing = false;
+        lock.Unlock();
+    };
+    Run([&]() -> Task<> {
+        TaskGroup group;
+        group.Spawn(reader());
+        group.Spawn(reader());
+        group.Spawn(writer());
+        group.Spawn(reader());  // 排在写者之后, 不能插队
+        co_await group.Wait();
+    }());
+    REQUIRE(max_readers == 2);
+    REQUIRE(order == std::vector<char>{'r', 'r', 'w', 'r'});
+}
@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+#include <thread>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+SCENARIO("test LatencyHistogram") {
+    GIVEN("empty histogram") {
+        LatencyHistogram histogram;
+        REQUIRE(histogram.Count() == 0);
+        REQUIRE(histogram.Min() == 0);
+        REQUIRE(histogram.Max() == 0);
+        REQUIRE(histogram.ValueAtPercentile(99) == 0);
+    }
+
+    GIVEN("small values are exact") {
+        LatencyHistogram histogram;
+        for (uint64_t i = 1; i <= 10; ++i) {
+            histogram.Record(i);
+        }
+        REQUIRE(histogram.Count() == 10);
+        REQUIRE(histogram.Sum() == 55);
+        REQUIRE(histogram.Min() == 1);
+        REQUIRE(histogram.Max() == 10);
+        REQUIRE(histogram.ValueAtPercentile(50) == 5);
+        REQUIRE(histogram.ValueAtPercentile(100) == 10);
+        REQUIRE(histogram.ValueAtPercentile(0) == 1);
+    }
+
+    GIVEN("percentiles within 1/16 relative error") {
+        LatencyHistogram histogram;
+        for (uint64_t i = 1; i <= 100'000; ++i) {
+            histogram.Record(i * 1000);  // 1us ~ 100ms
+        }
+        for (double p : {50.0, 90.0, 99.0, 99.9}) {
+            auto expected = static_cast<double>(p / 100 * 100'000 * 1000);
+            auto value = static_cast<double>(histogram.ValueAtPercentile(p));
+            REQUIRE(value >= expected);
+            REQUIRE(value <= expected * (1 + 1.0 / 16));
+        }
+        REQUIRE(histogram.ValueAtPercentile(100) == 100'000'000);
+    }
+
+    GIVEN("huge values and durations") {
+        LatencyHistogram histogram;
+        histogram.Record(std::numeric_limits<uint64_t>::max());
+        histogram.Record(-5ms);  // 负的时长记为 0
+        histogram.Record(2ms);
+        REQUIRE(histogram.Count() == 3);
+        REQUIRE(histogram.Min() == 0);
+        REQUIRE(histogram.ValueAtPercentile(100) == std::numeric_limits<uint64_t>::max());
+        auto p50 = histogram.ValueAtPercentile(50);
+        REQUIRE(p50 >= 2'000'000);
+        REQUIRE(p50 <= 2'000'000 * 17 / 16);
+    }
+
+    GIVEN("merge and reset") {
+        LatencyHistogram a, b;
+        a.Record(10);
+        b.Record(1000);
+        b.Record(20);
+        a.Merge(b);
+        REQUIRE(a.Count() == 3);
+        REQUIRE(a.Min() == 10);
+        REQUIRE(a.Max() == 1000);
+        a.Reset();
+        REQUIRE(a.Count() == 0);
+        REQUIRE(a.Sum() == 0);
+    }
+}
+
+SCENARIO("test event loop metrics") {
+    auto& loop = GetEventLoop();
+
+    GIVEN("disabled by default") {
+        loop.ResetMetrics();
+        Run([]() -> Task<> { co_await Sleep(1ms); }());
+        REQUIRE(!loop.IsMetricsEnabled());
+        REQUIRE(loop.Metrics().iterations == 0);
+    }
+
+#if ASYNCIO_ENABLE_LOOP_METRICS
+    GIVEN("slow callback and idle wait") {
+        loop.EnableMetrics();
+        loop.ResetMetrics();
+        Run([]() -> Task<> {
+            co_await Sleep(20ms);                       // Select 阻塞
+            std::this_thread::sleep_for(10ms);          // 慢回调
+            co_await Gather(Sleep(1ms), Sleep(1ms), Sleep(1ms));
+        }());
+        loop.EnableMetrics(false);
+
+        auto metrics = loop.Metrics();
+        REQUIRE(metrics.iterations > 0);
+        REQUIRE(metrics.callbacks >= 5);
+        REQUIRE(metrics.timers_fired >= 4);
+        REQUIRE(metrics.callback_time.Count() == metrics.callbacks);
+        REQUIRE(metrics.callback_time.Max() >= 10'000'000);  // 最慢的回调
+        REQUIRE(metrics.select_time.Sum() >= 15'000'000);
+        REQUIRE(metrics.callbacks_per_iteration.Count() == metrics.iterations);
+        REQUIRE(metrics.callbacks_per_iteration.Sum() == metrics.callbacks);
+        REQUIRE(metrics.Utilization() > 0.0);
+        REQUIRE(metrics.Utilization() < 1.0);
+        REQUIRE(metrics.ready_size == 0);
+
+        // 关闭后不再统计
+        Run([]() -> Task<> { co_await Sleep(1ms); }());
+        REQUIRE(loop.Metrics().iterations == metrics.iterations);
+    }
+
+    GIVEN("scrape from a task and export Prometheus text") {
+        loop.EnableMetrics();
+        loop.ResetMetrics();
+        std::string text;
+        Run([&]() -> Task<> {
+            for (int i = 0; i < 3; ++i) {
+                co_await Sleep(1ms);
+            }
+            text = FormatPrometheus(GetEventLoop().Metrics());
+        }());
+        loop.EnableMetrics(false);
+
+        REQUIRE(text.find("# TYPE asyncio_loop_iterations_total counter\n") != std::string::npos);
+        REQUIRE(text.find("# TYPE asyncio_loop_callback_seconds summary\n") != std::string::npos);
+        REQUIRE(text.find("asyncio_loop_callback_seconds{quantile=\"0.99\"} ") != std::string::npos);
+        REQUIRE(text.find("asyncio_loop_callback_seconds_count ") != std::string::npos);
+        REQUIRE(text.find("asyncio_loop_callback_seconds_max ") != std::string::npos);
+        REQUIRE(text.find("asyncio_loop_timer_backlog ") != std::string::npos);
+        REQUIRE(text.find("asyncio_loop_utilization_ratio ") != std::string::npos);
+        REQUIRE(text.find("asyncio_loop_iterations_total 0\n") == std::string::npos);
+    }
+#endif
+}
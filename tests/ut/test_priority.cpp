@@ -0,0 +1,167 @@
+#include <sys/socket.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<> record(std::vector<int>& order, int id) {
+    order.push_back(id);
+    co_return;
+}
+
+Task<Priority> current_priority() { co_return Handle::current_priority_; }
+
+// 阻塞的后台计算
+Task<> busy(int& done) {
+    std::this_thread::sleep_for(500us);
+    ++done;
+    co_return;
+}
+
+}  // namespace
+
+SCENARIO("test task priorities") {
+    auto& loop = GetEventLoop();
+
+    GIVEN("higher priorities run first") {
+        std::vector<int> order;
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            group.Spawn(record(order, 2), Priority::LOW);
+            group.Spawn(record(order, 1), Priority::NORMAL);
+            group.Spawn(record(order, 0), Priority::HIGH);
+            co_await group.Wait();
+        }());
+        REQUIRE(order == std::vector<int>{0, 1, 2});
+    }
+
+    GIVEN("schedule_task with a priority") {
+        std::vector<int> order;
+        Run([&]() -> Task<> {
+            auto low = schedule_task(record(order, 1), Priority::LOW);
+            auto high = schedule_task(record(order, 0), Priority::HIGH);
+            co_await low;
+            co_await high;
+        }());
+        REQUIRE(order == std::vector<int>{0, 1});
+    }
+
+    GIVEN("coroutines inherit the priority of their creator") {
+        Priority inherited = Priority::NORMAL;
+        Run([&]() -> Task<> {
+            auto child = [&]() -> Task<> {
+                co_await Sleep(1ms);  // 定时器句柄同样继承优先级
+                inherited = co_await current_priority();
+            };
+            TaskGroup group;
+            group.Spawn(child(), Priority::LOW);
+            co_await group.Wait();
+            REQUIRE(Handle::current_priority_ == Priority::NORMAL);
+        }());
+        REQUIRE(inherited == Priority::LOW);
+        REQUIRE(Handle::current_priority_ == Priority::NORMAL);
+    }
+
+    GIVEN("lanes are drained by weight without starving the low lane") {
+        std::vector<int> order;
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            for (int i = 0; i < 16; ++i) {
+                group.Spawn(record(order, 100 + i), Priority::LOW);
+                group.Spawn(record(order, i), Priority::HIGH);
+            }
+            co_await group.Wait();
+        }());
+        // 默认权重 HIGH 8 / LOW 1: 每执行 8 个高优先级任务执行 1 个低优先级任务
+        std::vector<int> expected;
+        for (int i = 0; i < 8; ++i) {
+            expected.push_back(i);
+        }
+        expected.push_back(100);
+        for (int i = 8; i < 16; ++i) {
+            expected.push_back(i);
+        }
+        for (int i = 101; i < 116; ++i) {
+            expected.push_back(i);
+        }
+        REQUIRE(order == expected);
+    }
+
+    GIVEN("custom weights") {
+        loop.SetPriorityWeights({1, 1, 1});
+        std::vector<int> order;
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            for (int i = 0; i < 3; ++i) {
+                group.Spawn(record(order, 100 + i), Priority::LOW);
+                group.Spawn(record(order, i), Priority::HIGH);
+            }
+            co_await group.Wait();
+        }());
+        REQUIRE(order == std::vector<int>{0, 100, 1, 101, 2, 102});
+        REQUIRE_THROWS_AS(loop.SetPriorityWeights({1, 0, 1}), std::invalid_argument);
+        loop.SetPriorityWeights({8, 4, 1});
+    }
+
+#if ASYNCIO_ENABLE_LOOP_METRICS
+    GIVEN("time slice returns to the selector between bulk callbacks") {
+        loop.SetTimeSlice(1ms);
+        loop.ResetMetrics();
+        loop.EnableMetrics();
+        int done = 0;
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            for (int i = 0; i < 10; ++i) {
+                group.Spawn(busy(done), Priority::LOW);
+            }
+            co_await group.Wait();
+        }());
+        loop.EnableMetrics(false);
+        loop.SetTimeSlice(0ns);
+        REQUIRE(done == 10);
+        REQUIRE(loop.Metrics().time_slices_expired >= 1);
+    }
+#endif
+
+    GIVEN("io wakeups left over by the time slice are not queued twice") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+        loop.SetTimeSlice(100us);
+        int reads = 0;
+        Run([&]() -> Task<> {
+            Stream reader{fds[0]};
+            bool stop = false;
+            auto spin = [&]() -> Task<> {
+                while (!stop) {
+                    std::this_thread::sleep_for(20us);
+                    co_await Yield();
+                }
+            };
+            // 读事件就绪的读协程留在就绪队列中时, 水平触发的事件在下次 Select 中再次报告
+            auto read = [&]() -> Task<> {
+                for (int i = 0; i < 20; ++i) {
+                    REQUIRE(::write(fds[1], "x", 1) == 1);
+                    auto data = co_await reader.Read(1);
+                    reads += static_cast<int>(data.size());
+                }
+                stop = true;
+            };
+            TaskGroup group;
+            for (int i = 0; i < 5; ++i) {
+                group.Spawn(spin(), Priority::LOW);
+            }
+            group.Spawn(read(), Priority::LOW);
+            co_await group.Wait();
+        }());
+        loop.SetTimeSlice(0ns);
+        ::close(fds[1]);
+        REQUIRE(reads == 20);
+    }
+}
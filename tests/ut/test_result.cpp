@@ -225,3 +225,56 @@ SCENARIO("test pass parameters to the coroutine frame") {
         REQUIRE(TestCounted::alive_counts() == 0);
     }
 }
+
+SCENARIO("test result error code") {
+    GIVEN("result with value") {
+        Result<int> res{42};
+        REQUIRE(res.IsOk());
+        REQUIRE(res);
+        REQUIRE(*res == 42);
+        REQUIRE(!res.Error());
+    }
+
+    GIVEN("result with error code") {
+        Result<int> res{std::make_error_code(std::errc::connection_reset)};
+        REQUIRE(res.HasValue());
+        REQUIRE(!res.IsOk());
+        REQUIRE(res.Error() == std::errc::connection_reset);
+        REQUIRE_THROWS_AS(res.GetResult(), std::system_error);
+        REQUIRE_THROWS_AS(std::move(res).GetResult(), std::system_error);
+    }
+
+    GIVEN("result with exception") {
+        Result<int> res;
+        res.SetException(std::make_exception_ptr(std::runtime_error{"oops"}));
+        REQUIRE(!res.IsOk());
+        REQUIRE(!res.Error());
+        REQUIRE_THROWS_AS(res.GetResult(), std::runtime_error);
+    }
+
+    GIVEN("void result") {
+        REQUIRE(!Result<void>{}.IsOk());
+        auto ok = Result<void>::Ok();
+        REQUIRE(ok.IsOk());
+        REQUIRE_NOTHROW(ok.GetResult());
+
+        Result<void> err{std::make_error_code(std::errc::broken_pipe)};
+        REQUIRE(err.HasValue());
+        REQUIRE(!err.IsOk());
+        REQUIRE(err.Error() == std::errc::broken_pipe);
+        REQUIRE_THROWS_AS(err.GetResult(), std::system_error);
+    }
+
+    GIVEN("task returns error code") {
+        auto coro = [](bool fail) -> Task<Result<int>> {
+            if (fail) {
+                co_return std::make_error_code(std::errc::timed_out);
+            }
+            co_return 1;
+        };
+        auto ok = Run(coro(false));
+        REQUIRE(*ok == 1);
+        auto err = Run(coro(true));
+        REQUIRE(err.Error() == std::errc::timed_out);
+    }
+}
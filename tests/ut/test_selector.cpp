@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include <asyncio/event_loop.hpp>
+#include <thread>
 
 using namespace asyncio;
 using namespace std::chrono_literals;
@@ -7,8 +8,155 @@ using namespace std::chrono_literals;
 SCENARIO("test selector") {
     EventLoop loop;
     Selector selector;
+    // time() 是事件循环缓存的时间, 在循环外需手动刷新
+    loop.UpdateTime();
     auto before_wait = loop.time();
-    selector.Select(300);
+    selector.Select(300ms);
+    loop.UpdateTime();
     auto after_wait = loop.time();
     REQUIRE(after_wait - before_wait >= 300ms);
 }
+
+SCENARIO("test poll selector") {
+    EventLoop loop;
+    PollSelector selector;
+    REQUIRE(selector.IsStop());
+
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    Event event{.fd = fds[0], .flags = Event::EVENT_READ};
+    selector.RegisterEvent(event);
+    REQUIRE(!selector.IsStop());
+
+    loop.UpdateTime();
+    auto before_wait = loop.time();
+    REQUIRE(selector.Select(100ms).empty());
+    loop.UpdateTime();
+    REQUIRE(loop.time() - before_wait >= 100ms);
+
+    // 没有回调时标记为就绪 (与 EpollSelector 一致)
+    REQUIRE(::write(fds[1], "x", 1) == 1);
+    REQUIRE(selector.Select(0ms).empty());
+    REQUIRE(event.handle_info.handle == (Handle*)&event.handle_info.handle);
+
+    selector.RemoveEvent(event);
+    REQUIRE(selector.IsStop());
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+namespace {
+
+// 记录执行顺序的普通句柄
+struct RecordHandle : Handle {
+    RecordHandle(std::vector<int>& order, int id) : order_(order), id_(id) {}
+
+    void Run() override { order_.push_back(id_); }
+
+    std::vector<int>& order_;
+    int id_;
+};
+
+template <typename Queue>
+void CheckReadyQueue() {
+    Queue queue;
+    REQUIRE(queue.Empty());
+    // 交错入队出队, 覆盖环形缓冲区的回绕与扩容
+    HandleId next_push = 0, next_pop = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            queue.Push({.id = next_push++});
+        }
+        for (int i = 0; i < 70; ++i) {
+            REQUIRE(queue.Front().id == next_pop++);
+            queue.Pop();
+        }
+    }
+    REQUIRE(queue.Size() == next_push - next_pop);
+    while (!queue.Empty()) {
+        REQUIRE(queue.Front().id == next_pop++);
+        queue.Pop();
+    }
+}
+
+template <typename Timers>
+void CheckTimerQueue() {
+    Timers timers;
+    std::vector<int64_t> whens;
+    for (HandleId i = 0; i < 1000; ++i) {
+        int64_t when = (i * 7919) % 1000;
+        whens.push_back(when);
+        timers.Push({std::chrono::milliseconds(when), {.id = i}});
+    }
+    // 移除奇数 ID 后依然有序
+    REQUIRE(timers.EraseIf([](TimerEntry const& timer) { return timer.second.id % 2 == 1; }) == 500);
+    REQUIRE(timers.Size() == 500);
+    std::chrono::nanoseconds last{-1};
+    while (!timers.Empty()) {
+        auto [when, info] = timers.Top();
+        REQUIRE(info.id % 2 == 0);
+        REQUIRE(when == std::chrono::milliseconds(whens[info.id]));
+        REQUIRE(when >= last);
+        last = when;
+        timers.Pop();
+    }
+}
+
+template <typename Clock>
+void CheckClock(std::chrono::nanoseconds resolution) {
+    auto before = Clock::Now();
+    std::this_thread::sleep_for(5ms);
+    auto after = Clock::Now();
+    REQUIRE(after - before >= 5ms - resolution);
+    REQUIRE(after - before < 1s);
+}
+
+template <typename Loop>
+void CheckEventLoop() {
+    Loop loop;
+    std::vector<int> order;
+    RecordHandle soon{order, 1}, later{order, 3}, sooner{order, 2}, cancelled{order, 4};
+    loop.CallLater(20ms, later);
+    loop.CallLater(10ms, cancelled);
+    loop.CallSoon(soon);
+    loop.CallLater(0ms, sooner);
+    loop.CancelHandle(cancelled);
+    loop.RunUntilComplete();
+    REQUIRE(order == std::vector<int>{1, 2, 3});
+}
+
+}  // namespace
+
+SCENARIO("test event loop policies") {
+    GIVEN("ready queues") {
+        CheckReadyQueue<DequeReadyQueue>();
+        CheckReadyQueue<RingReadyQueue>();
+    }
+
+    GIVEN("timer queues") {
+        CheckTimerQueue<HeapTimerQueue>();
+        CheckTimerQueue<QuadHeapTimerQueue>();
+    }
+
+    GIVEN("event loops with non-default policies") {
+        CheckEventLoop<BasicEventLoop<PollSelector, QuadHeapTimerQueue, RingReadyQueue>>();
+        CheckEventLoop<BasicEventLoop<EpollSelector, QuadHeapTimerQueue, DequeReadyQueue>>();
+        CheckEventLoop<BasicEventLoop<PollSelector, HeapTimerQueue, RingReadyQueue>>();
+        CheckEventLoop<BasicEventLoop<EpollSelector, HeapTimerQueue, DequeReadyQueue, CoarseMonotonicClock>>();
+#if defined(__x86_64__) || defined(__i386__)
+        CheckEventLoop<BasicEventLoop<EpollSelector, HeapTimerQueue, DequeReadyQueue, TscClock>>();
+#endif
+    }
+
+    GIVEN("clocks") {
+        CheckClock<MonotonicClock>(0ns);
+        // 粗粒度时钟的精度为一个时钟节拍
+        CheckClock<CoarseMonotonicClock>(10ms);
+#if defined(__x86_64__) || defined(__i386__)
+        CheckClock<TscClock>(0ns);
+        // TSC 以 CLOCK_MONOTONIC 为基准校准, 两者相差不超过 1ms
+        auto drift = TscClock::Now() - MonotonicClock::Now();
+        REQUIRE(std::chrono::abs(drift) < 1ms);
+#endif
+    }
+}
@@ -1,7 +1,11 @@
+#include <arpa/inet.h>
+
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <asyncio/asyncio.hpp>
 #include <functional>
+#include <memory_resource>
+#include <numeric>
 
 using namespace asyncio;
 using namespace std::chrono_literals;
@@ -234,6 +238,151 @@ SCENARIO("test Gather") {
     }
 }
 
+SCENARIO("test GatherAll") {
+    auto delayed_square = [](int x) -> Task<int> {
+        co_await Sleep(std::chrono::milliseconds(10 * (5 - x)));
+        co_return x * x;
+    };
+
+    SECTION("collect results in input order") {
+        Run([&]() -> Task<> {
+            std::vector<Task<int>> tasks;
+            for (int i = 0; i < 5; ++i) {
+                tasks.push_back(delayed_square(i));
+            }
+            auto results = co_await GatherAll(std::move(tasks));
+            REQUIRE(results == std::vector<int>{0, 1, 4, 9, 16});
+            REQUIRE((co_await GatherAll(std::vector<Task<int>>{})).empty());
+        }());
+    }
+
+    SECTION("void tasks & exception") {
+        int count = 0;
+        auto incr = [&]() -> Task<> {
+            ++count;
+            co_return;
+        };
+        Run([&]() -> Task<> {
+            std::vector<Task<>> tasks;
+            tasks.push_back(incr());
+            tasks.push_back(incr());
+            co_await GatherAll(std::move(tasks));
+        }());
+        REQUIRE(count == 2);
+
+        REQUIRE_THROWS_AS(Run([&]() -> Task<> {
+                              std::vector<Task<double>> tasks;
+                              tasks.push_back(int_div(4, 2));
+                              tasks.push_back(int_div(4, 0));
+                              co_await GatherAll(std::move(tasks));
+                          }()),
+                          std::overflow_error);
+    }
+}
+
+SCENARIO("test MapConcurrent") {
+    size_t in_flight = 0;
+    size_t max_in_flight = 0;
+    auto fetch = [&](int x) -> Task<int> {
+        max_in_flight = std::max(max_in_flight, ++in_flight);
+        co_await Sleep(std::chrono::milliseconds(x % 3));
+        --in_flight;
+        co_return x * 2;
+    };
+
+    Run([&]() -> Task<> {
+        std::vector<int> inputs(100);
+        std::iota(inputs.begin(), inputs.end(), 0);
+        auto results = co_await MapConcurrent(inputs, fetch, 8);
+        REQUIRE(results.size() == 100);
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(results[i] == i * 2);
+        }
+        REQUIRE(max_in_flight == 8);
+
+        max_in_flight = 0;
+        auto ranged = co_await MapConcurrent(std::views::iota(0, 10), fetch, 20);
+        REQUIRE(ranged.size() == 10);
+        REQUIRE(max_in_flight == 10);
+    }());
+}
+
+SCENARIO("test WhenAny") {
+    auto delayed = [](int x, std::chrono::milliseconds delay) -> Task<int> {
+        co_await Sleep(delay);
+        co_return x;
+    };
+
+    SECTION("first completed wins") {
+        Run([&]() -> Task<> {
+            auto [index, value] = co_await WhenAny(delayed(1, 50ms), delayed(2, 10ms));
+            REQUIRE(index == 1);
+            REQUIRE(std::get<1>(value) == 2);
+
+            std::vector<Task<int>> tasks;
+            for (int i = 0; i < 5; ++i) {
+                tasks.push_back(delayed(i, std::chrono::milliseconds(10 * (5 - i))));
+            }
+            auto [first, result] = co_await WhenAny(std::move(tasks));
+            REQUIRE(first == 4);
+            REQUIRE(result == 4);
+        }());
+    }
+
+    SECTION("losers are cancelled and their timers released") {
+        bool loser_finished = false;
+        auto loser = [&]() -> Task<> {
+            co_await Sleep(1h);
+            loser_finished = true;
+        };
+        auto before = GetEventLoop().time();
+        Run([&]() -> Task<> {
+            auto [index, _] = co_await WhenAny(loser(), delayed(0, 10ms));
+            REQUIRE(index == 1);
+        }());
+        REQUIRE(!loser_finished);
+        REQUIRE(GetEventLoop().time() - before < 1s);  // Run 不会因残留的 1h 定时器而阻塞
+    }
+
+    SECTION("losers' io registration released") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+        Run([&]() -> Task<> {
+            Stream stream{fds[0]};
+            auto read_forever = [&]() -> Task<Stream::Buffer> { co_return co_await stream.Read(10); };
+            auto [index, value] = co_await WhenAny(read_forever(), delayed(0, 10ms));
+            REQUIRE(index == 1);
+        }());
+        ::close(fds[1]);
+    }
+
+    SECTION("loser's stream outlives the race and receives data afterwards") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+        Run([&]() -> Task<> {
+            Stream stream{fds[0]};
+            auto read = [&]() -> Task<Stream::Buffer> { co_return co_await stream.Read(10); };
+            auto [index, value] = co_await WhenAny(read(), delayed(0, 10ms));
+            REQUIRE(index == 1);
+            // 输家的帧已销毁: 数据到达时事件循环不能再恢复它
+            REQUIRE(::write(fds[1], "hello", 5) == 5);
+            co_await Sleep(10ms);
+            auto data = co_await stream.Read(10);
+            REQUIRE(std::string_view(data.data(), data.size()) == "hello");
+        }());
+        ::close(fds[1]);
+    }
+
+    SECTION("exception of the first completed") {
+        REQUIRE_THROWS_AS(Run([&]() -> Task<> {
+                              co_await WhenAny(int_div(4, 0), delayed(0, 10ms));
+                          }()),
+                          std::overflow_error);
+        REQUIRE_THROWS_AS(Run([&]() -> Task<> { co_await WhenAny(std::vector<Task<int>>{}); }()),
+                          std::invalid_argument);
+    }
+}
+
 // SCENARIO("test Sleep") {
 //     size_t call_time = 0;
 //     auto say_after = [&](auto delay, std::string_view what) -> Task<> {
@@ -409,3 +558,443 @@ SCENARIO("echo server & client") {
 
     REQUIRE(is_called);
 }
+
+SCENARIO("Stream Write to a blocking pipe does not block the loop") {
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);  // 阻塞的管道, 缓冲区远小于写入的数据
+    Run([read_fd = fds[0], write_fd = fds[1]]() -> Task<> {
+        Stream reader{read_fd}, writer{write_fd};
+        Stream::Buffer big(1024 * 1024, 'x');
+        size_t total = 0;
+        auto drain = [&]() -> Task<> {
+            while (total < big.size()) {
+                total += (co_await reader.Read(64 * 1024)).size();
+            }
+        };
+        // 写满管道时等待可写, 而不是阻塞在 write 中 (读端在同一个事件循环上, 否则死锁)
+        co_await Gather(writer.Write(big), drain());
+        REQUIRE(total == big.size());
+    }());
+}
+
+#if ASYNCIO_ENABLE_LOOP_METRICS
+SCENARIO("Stream Write does not leave the loop busy polling") {
+    int fds[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+    Run([local_fd = fds[0], peer_fd = fds[1]]() -> Task<> {
+        Stream local{local_fd}, peer{peer_fd};
+        auto& loop = GetEventLoop();
+        // 空闲 100ms 期间的迭代次数: 阻塞在 Select 中时只有几次, 空转时数万次
+        auto idle_iterations = [&]() -> Task<uint64_t> {
+            loop.ResetMetrics();
+            loop.EnableMetrics();
+            co_await Sleep(100ms);
+            loop.EnableMetrics(false);
+            co_return loop.Metrics().iterations;
+        };
+
+        // 直接写入, 不经过可写事件
+        co_await local.Write(Stream::Buffer(16, 'x'));
+        co_await peer.Read(16);
+        auto iterations = co_await idle_iterations();
+        REQUIRE(iterations < 10);
+
+        // 写满发送缓冲区: 等待可写, 写完后注销可写事件
+        Stream::Buffer big(4 * 1024 * 1024, 'x');
+        auto drain = [&]() -> Task<> {
+            for (size_t total = 0; total < big.size();) {
+                total += (co_await peer.Read(64 * 1024)).size();
+            }
+        };
+        co_await Gather(local.Write(big), drain());
+        iterations = co_await idle_iterations();
+        REQUIRE(iterations < 10);
+
+        // 等待可写后出错 (对端关闭): 同样注销可写事件
+        auto close_peer = [&]() -> Task<> {
+            co_await Sleep(10ms);
+            peer.Close();
+        };
+        auto&& [written, _void] = co_await Gather(local.TryWrite(big), close_peer());
+        REQUIRE(!written.IsOk());
+        iterations = co_await idle_iterations();
+        REQUIRE(iterations < 10);
+    }());
+}
+
+SCENARIO("sub-millisecond timers do not busy poll") {
+    Run([]() -> Task<> {
+        auto& loop = GetEventLoop();
+        loop.ResetMetrics();
+        loop.EnableMetrics();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 10; ++i) {
+            co_await Sleep(200us);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        loop.EnableMetrics(false);
+        // 纳秒精度的 Select 超时: 每次 Sleep 只需一两次迭代, 而不是把超时截断为 0 后空转
+        REQUIRE(elapsed >= 2ms);
+        REQUIRE(loop.Metrics().iterations < 100);
+    }());
+}
+#endif
+
+SCENARIO("test error code path") {
+    GIVEN("TryWaitFor") {
+        auto never = []() -> Task<int> {
+            co_await Sleep(1h);
+            co_return 0;
+        };
+        auto value = []() -> Task<int> { co_return 7; };
+        Run([&]() -> Task<> {
+            auto timeout = co_await TryWaitFor(never(), 10ms);
+            REQUIRE(timeout.Error() == std::errc::timed_out);
+            auto done = co_await TryWaitFor(value(), 100ms);
+            REQUIRE(done.IsOk());
+            REQUIRE(*done == 7);
+            auto slept = co_await TryWaitFor(Sleep(1ms), 100ms);
+            REQUIRE(slept.IsOk());
+        }());
+    }
+
+    GIVEN("stream read timed out by TryWaitFor is usable afterwards") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+        Run([&]() -> Task<> {
+            Stream stream{fds[0]};
+            auto read = [&]() -> Task<Stream::Buffer> { co_return co_await stream.Read(10); };
+            auto timeout = co_await TryWaitFor(read(), 10ms);
+            REQUIRE(timeout.Error() == std::errc::timed_out);
+            REQUIRE(::write(fds[1], "hello", 5) == 5);
+            co_await Sleep(10ms);  // 超时的读协程不能被数据唤醒
+            auto data = co_await stream.Read(10);
+            REQUIRE(std::string_view(data.data(), data.size()) == "hello");
+        }());
+        ::close(fds[1]);
+    }
+
+    GIVEN("TryRead & TryWrite on a closed peer") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+        Run([local_fd = fds[0], peer_fd = fds[1]]() -> Task<> {
+            Stream local{local_fd};
+            Stream::Buffer hello(2, 'h'), byte(1, 'x');
+            {
+                Stream peer{peer_fd};
+                auto written = co_await peer.TryWrite(hello);
+                REQUIRE(written.IsOk());
+            }
+            auto data = co_await local.TryRead();  // 读到 EOF
+            REQUIRE(data.IsOk());
+            REQUIRE(data->size() == 2);
+            auto broken = co_await local.TryWrite(byte);
+            REQUIRE(broken.Error() == std::errc::broken_pipe);
+            bool thrown = false;
+            try {
+                co_await local.Write(byte);
+            } catch (std::system_error const&) {
+                thrown = true;
+            }
+            REQUIRE(thrown);
+        }());
+    }
+
+    GIVEN("TryOpenConnection to a non-listening port") {
+        Run([]() -> Task<> {
+            auto stream = co_await TryOpenConnection("127.0.0.1", 8898);
+            REQUIRE(!stream.IsOk());
+            REQUIRE(stream.Error() == std::errc::address_not_available);
+            auto timeout = co_await TryOpenConnection("::1", 8898, {.attempt_timeout = 100ms});
+            REQUIRE(!timeout.IsOk());
+        }());
+    }
+}
+
+#if ASYNCIO_ENABLE_FRAME_ALLOCATOR
+namespace {
+
+// 按请求分配的内存池: 只分配, 释放只做计数, Reset() 时整体回收
+struct Arena {
+    alignas(std::max_align_t) std::byte buffer[4096];
+    size_t used{0};
+    size_t allocations{0};
+    size_t deallocations{0};
+
+    void* Allocate(size_t bytes, size_t align) {
+        used = (used + align - 1) & ~(align - 1);
+        if (used + bytes > sizeof(buffer)) {
+            throw std::bad_alloc{};
+        }
+        ++allocations;
+        return buffer + std::exchange(used, used + bytes);
+    }
+
+    bool Owns(void const* ptr) const { return ptr >= buffer && ptr < buffer + sizeof(buffer); }
+
+    void Reset() { used = allocations = deallocations = 0; }
+};
+
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& arena) : arena_(&arena) {}
+
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const& other) : arena_(other.arena_) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T))); }
+
+    void deallocate(T*, size_t) { ++arena_->deallocations; }
+
+    bool operator==(ArenaAllocator const&) const = default;
+
+    Arena* arena_;
+};
+
+Task<int> ArenaAdd(std::allocator_arg_t, ArenaAllocator<int>, int a, int b) {
+    co_await Sleep(1ms);
+    co_return a + b;
+}
+
+Task<> ArenaThrow(std::allocator_arg_t, ArenaAllocator<int>) {
+    co_await Sleep(1ms);
+    throw std::runtime_error("arena");
+}
+
+// 记录最近一次分配的地址
+struct RecordingResource : std::pmr::memory_resource {
+    explicit RecordingResource(std::pmr::memory_resource* upstream) : upstream_(upstream) {}
+
+    void* do_allocate(size_t bytes, size_t align) override {
+        return last_ = upstream_->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t align) override {
+        upstream_->deallocate(ptr, bytes, align);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    void* last_{};
+};
+
+Task<int> PmrValue(std::allocator_arg_t, std::pmr::polymorphic_allocator<>, int x) { co_return x; }
+
+struct Handler {
+    Task<int> Handle(std::allocator_arg_t, ArenaAllocator<int>, int x) {
+        co_await Sleep(1ms);
+        co_return x * factor;
+    }
+
+    int factor{3};
+};
+
+}  // namespace
+
+SCENARIO("test allocator aware Task") {
+    Arena arena;
+
+    GIVEN("free function coroutine") {
+        auto task = ArenaAdd(std::allocator_arg, ArenaAllocator<int>{arena}, 1, 2);
+        REQUIRE(arena.allocations == 1);
+        REQUIRE(arena.used > sizeof(Task<int>::promise_type));
+        REQUIRE(Run(std::move(task)) == 3);
+        REQUIRE(arena.deallocations == 1);
+    }
+
+    GIVEN("member function coroutine") {
+        Handler handler;
+        REQUIRE(Run(handler.Handle(std::allocator_arg, ArenaAllocator<int>{arena}, 5)) == 15);
+        REQUIRE(arena.allocations == 1);
+        REQUIRE(arena.deallocations == 1);
+    }
+
+    GIVEN("nested coroutines in one arena, freed in bulk") {
+        Run([&]() -> Task<> {
+            for (int i = 0; i < 3; ++i) {
+                auto sum = co_await ArenaAdd(std::allocator_arg, ArenaAllocator<int>{arena}, i, i);
+                REQUIRE(sum == 2 * i);
+            }
+            REQUIRE(arena.allocations == 3);
+            REQUIRE(arena.deallocations == 3);
+            arena.Reset();
+            REQUIRE_THROWS_AS(co_await ArenaThrow(std::allocator_arg, ArenaAllocator<int>{arena}),
+                              std::runtime_error);
+            REQUIRE(arena.allocations == 1);
+            REQUIRE(arena.deallocations == 1);
+        }());
+    }
+
+    GIVEN("cancelled before completion") {
+        {
+            auto task = schedule_task(ArenaAdd(std::allocator_arg, ArenaAllocator<int>{arena}, 1, 2));
+            REQUIRE(arena.allocations == 1);
+        }
+        REQUIRE(arena.deallocations == 1);
+    }
+
+    GIVEN("std::pmr allocator keeps frame alignment") {
+        std::byte buffer[1024];
+        std::pmr::monotonic_buffer_resource resource{buffer + 1, sizeof(buffer) - 1,
+                                                     std::pmr::null_memory_resource()};
+        RecordingResource recording{&resource};
+        REQUIRE(Run(PmrValue(std::allocator_arg, &recording, 4)) == 4);
+        auto address = reinterpret_cast<std::uintptr_t>(recording.last_);
+        REQUIRE(address % __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0);
+        REQUIRE(address >= reinterpret_cast<std::uintptr_t>(buffer));
+        REQUIRE(address < reinterpret_cast<std::uintptr_t>(buffer + sizeof(buffer)));
+    }
+
+    GIVEN("other coroutines still use the global allocator") {
+        REQUIRE(Run(Handler{}.Handle(std::allocator_arg, ArenaAllocator<int>{arena}, 1)) == 3);
+        auto plain = []() -> Task<int> { co_return 1; };
+        REQUIRE(Run(plain()) == 1);
+        REQUIRE(arena.allocations == 1);
+    }
+}
+#endif
+
+namespace {
+
+// 黑洞监听: backlog 填满后新的 SYN 会被丢弃, connect 一直处于进行中
+struct BlackholeListener {
+    explicit BlackholeListener(uint16_t port) {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        listenfd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        int yes = 1;
+        setsockopt(listenfd_, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+        REQUIRE(bind(listenfd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+        REQUIRE(listen(listenfd_, 0) == 0);
+        for (int i = 0; i < 8; ++i) {
+            pending_.push_back(::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0));
+            ::connect(pending_.back(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        }
+    }
+
+    ~BlackholeListener() {
+        for (int fd : pending_) {
+            close(fd);
+        }
+        close(listenfd_);
+    }
+
+    int listenfd_;
+    std::vector<int> pending_;
+};
+
+// 按给定顺序排列的解析结果 (getaddrinfo 的链表形式)
+struct ResolvedAddresses {
+    ResolvedAddresses(std::initializer_list<std::pair<char const*, uint16_t>> addrs)
+        : storage_(addrs.size()), infos_(addrs.size()) {
+        size_t i = 0;
+        for (auto [ip, port] : addrs) {
+            auto& info = infos_[i];
+            auto& storage = storage_[i];
+            if (std::string_view{ip}.find(':') != std::string_view::npos) {
+                auto& addr6 = reinterpret_cast<sockaddr_in6&>(storage);
+                addr6.sin6_family = AF_INET6;
+                addr6.sin6_port = htons(port);
+                inet_pton(AF_INET6, ip, &addr6.sin6_addr);
+                info.ai_family = AF_INET6;
+                info.ai_addrlen = sizeof(sockaddr_in6);
+            } else {
+                auto& addr4 = reinterpret_cast<sockaddr_in&>(storage);
+                addr4.sin_family = AF_INET;
+                addr4.sin_port = htons(port);
+                inet_pton(AF_INET, ip, &addr4.sin_addr);
+                info.ai_family = AF_INET;
+                info.ai_addrlen = sizeof(sockaddr_in);
+            }
+            info.ai_socktype = SOCK_STREAM;
+            info.ai_addr = reinterpret_cast<sockaddr*>(&storage);
+            info.ai_next = ++i < infos_.size() ? &infos_[i] : nullptr;
+        }
+    }
+
+    addrinfo const* Head() const { return infos_.data(); }
+
+    std::vector<sockaddr_storage> storage_;
+    std::vector<addrinfo> infos_;
+};
+
+}  // namespace
+
+SCENARIO("test OpenConnection") {
+    auto echo_server = [](std::string_view ip, uint16_t port) -> Task<> {
+        auto server = co_await StartServer(
+            [](Stream stream) -> Task<> { co_await stream.Write(co_await stream.Read(100)); }, ip,
+            port);
+        co_await server.ServeForever();
+    };
+    auto connect = [](std::string_view ip, uint16_t port, ConnectOptions options) -> Task<> {
+        co_await OpenConnection(ip, port, options);
+    };
+
+    GIVEN("connect ipv4 & ipv6 loopback listener") {
+        Run([&]() -> Task<> {
+            auto srv4 = schedule_task(echo_server("127.0.0.1", 8896));
+            auto srv6 = schedule_task(echo_server("::1", 8897));
+            auto stream4 = co_await OpenConnection("127.0.0.1", 8896);
+            REQUIRE(stream4.GetSockInfo().ss_family == AF_INET);
+            auto stream6 = co_await OpenConnection("::1", 8897);
+            REQUIRE(stream6.GetSockInfo().ss_family == AF_INET6);
+            srv4.Cancel();
+            srv6.Cancel();
+        }());
+    }
+
+    GIVEN("connect non-listening port") {
+        REQUIRE_THROWS_AS(Run(connect("127.0.0.1", 8898, {})), std::system_error);
+        REQUIRE_THROWS_AS(Run(connect("::1", 8898, {.attempt_timeout = 100ms})),
+                          std::system_error);
+    }
+
+    GIVEN("connect timeout") {
+        BlackholeListener blackhole{8899};
+        auto before = GetEventLoop().time();
+        REQUIRE_THROWS_AS(Run(connect("127.0.0.1", 8899, {.connect_timeout = 100ms})),
+                          std::system_error);
+        REQUIRE_THROWS_AS(Run(connect("127.0.0.1", 8899, {.attempt_timeout = 100ms})),
+                          std::system_error);
+        REQUIRE(GetEventLoop().time() - before < 1s);
+    }
+
+    // 双栈域名: 注入两个地址族的解析结果, 只有一个地址族有监听
+    GIVEN("dual-stack name falls back to the other family after attempt_delay") {
+        BlackholeListener blackhole{8900};
+        ResolvedAddresses addrs{{"127.0.0.1", 8900}, {"127.0.0.1", 8900}, {"::1", 8901}};
+        auto start = std::chrono::steady_clock::now();
+        Run([&]() -> Task<> {
+            auto srv6 = schedule_task(echo_server("::1", 8901));
+            // 交错排列后 ::1 是第二个尝试: 在第一个尝试挂起 attempt_delay 之后启动
+            auto stream = co_await detail::ConnectAddresses(addrs.Head(), {.attempt_delay = 150ms});
+            REQUIRE(stream.IsOk());
+            REQUIRE(stream->GetSockInfo().ss_family == AF_INET6);
+            srv6.Cancel();
+        }());
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        REQUIRE(elapsed >= 150ms);
+        REQUIRE(elapsed < 300ms);  // 没有交错时要等两个 attempt_delay
+    }
+
+    GIVEN("dual-stack name falls back at once when the first family refuses") {
+        ResolvedAddresses addrs{{"::1", 8902}, {"127.0.0.1", 8903}};
+        auto start = std::chrono::steady_clock::now();
+        Run([&]() -> Task<> {
+            auto srv4 = schedule_task(echo_server("127.0.0.1", 8903));
+            auto stream = co_await detail::ConnectAddresses(addrs.Head(), {.attempt_delay = 1s});
+            REQUIRE(stream.IsOk());
+            REQUIRE(stream->GetSockInfo().ss_family == AF_INET);
+            srv4.Cancel();
+        }());
+        REQUIRE(std::chrono::steady_clock::now() - start < 500ms);
+    }
+}
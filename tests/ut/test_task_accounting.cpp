@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+#include <thread>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<> busy_child() {
+    std::this_thread::sleep_for(20ms);  // 模拟占用 CPU
+    co_await Sleep(1ms);
+}
+
+Task<> heavy_handler() {
+    SetTaskLabel("heavy");
+    co_await busy_child();  // 子协程继承标签
+    co_await busy_child();
+}
+
+Task<> light_handler() {
+    SetTaskLabel("light");
+    co_await Sleep(30ms);  // 挂起时间长, 运行时间短
+}
+
+Task<> unlabeled_handler() { co_await busy_child(); }
+
+Task<> serve() {
+    TaskGroup group;
+    group.Spawn(heavy_handler());
+    group.Spawn(light_handler());
+    co_await group.Wait();
+}
+
+TaskStats const* Find(std::vector<TaskStats> const& stats, std::string_view label) {
+    for (auto const& s : stats) {
+        if (s.label == label) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+SCENARIO("test task accounting") {
+    auto& loop = GetEventLoop();
+
+#if ASYNCIO_ENABLE_LOOP_DEBUG
+    GIVEN("labels are inherited by awaited coroutines") {
+        loop.EnableTaskAccounting();
+        Run(serve());
+        loop.DisableTaskAccounting();
+
+        auto stats = loop.GetTaskAccounting()->Stats();
+        auto heavy = Find(stats, "heavy");
+        auto light = Find(stats, "light");
+        REQUIRE(heavy != nullptr);
+        REQUIRE(light != nullptr);
+        REQUIRE(heavy->cpu_time >= 40ms);
+        REQUIRE(heavy->max_run >= 20ms);
+        REQUIRE(heavy->wakeups >= 4);  // heavy_handler 与两个 busy_child 各自至少运行一次
+        REQUIRE(light->cpu_time < 20ms);
+        REQUIRE(light->suspended_time >= 30ms);
+        REQUIRE(light->wakeups >= 1);  // 设置标签的那次运行归到设置之前的标签
+
+        auto top = loop.GetTaskAccounting()->Top(1);
+        REQUIRE(top.size() == 1);
+        REQUIRE(top[0].label == "heavy");
+        auto by_suspended = loop.GetTaskAccounting()->Top(10, TaskStatsOrder::SUSPENDED_TIME);
+        REQUIRE(by_suspended.size() == stats.size());
+        REQUIRE(by_suspended[0].suspended_time >= by_suspended.back().suspended_time);
+    }
+
+#if ASYNCIO_ENABLE_FRAME_INFO
+    GIVEN("unlabeled time goes to the top-level task") {
+        loop.EnableTaskAccounting();
+        Run(unlabeled_handler());
+        loop.DisableTaskAccounting();
+
+        auto top = loop.GetTaskAccounting()->Top(1);
+        REQUIRE(top.size() == 1);
+        REQUIRE(top[0].label.find("unlabeled_handler") != std::string::npos);
+        REQUIRE(top[0].cpu_time >= 20ms);
+    }
+#endif
+
+    GIVEN("disabled and reset") {
+        loop.EnableTaskAccounting();
+        Run(heavy_handler());
+        loop.DisableTaskAccounting();
+        auto wakeups = Find(loop.GetTaskAccounting()->Stats(), "heavy")->wakeups;
+        Run(heavy_handler());  // 停止后不再统计
+        REQUIRE(Find(loop.GetTaskAccounting()->Stats(), "heavy")->wakeups == wakeups);
+        loop.ResetTaskAccounting();
+        REQUIRE(loop.GetTaskAccounting()->Stats().empty());
+    }
+#else
+    GIVEN("compiled out") {
+        loop.EnableTaskAccounting();
+        Run(heavy_handler());
+        loop.DisableTaskAccounting();
+        REQUIRE(loop.GetTaskAccounting()->Stats().empty());
+    }
+#endif
+}
@@ -0,0 +1,203 @@
+#include <sys/socket.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<> sleep_then(std::chrono::milliseconds delay, std::vector<int>& done, int id) {
+    co_await Sleep(delay);
+    done.push_back(id);
+}
+
+// 一直睡眠, 被取消时记录
+Task<> sleep_forever(int& cancelled) {
+    try {
+        co_await Sleep(1h);
+    } catch (CancelledError const&) {
+        ++cancelled;
+        throw;
+    }
+}
+
+Task<> fail_after(std::chrono::milliseconds delay) {
+    co_await Sleep(delay);
+    throw std::runtime_error("child failed");
+}
+
+}  // namespace
+
+SCENARIO("test TaskGroup") {
+    GIVEN("wait all children") {
+        std::vector<int> done;
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            group.Spawn(sleep_then(30ms, done, 0));
+            group.Spawn(sleep_then(10ms, done, 1));
+            group.Spawn(sleep_then(20ms, done, 2));
+            REQUIRE(group.Size() == 3);
+            co_await group.Wait();
+            REQUIRE(group.Size() == 0);
+        }());
+        REQUIRE(done == std::vector<int>{1, 2, 0});
+    }
+
+    GIVEN("first exception cancels siblings") {
+        int cancelled = 0;
+        auto before = GetEventLoop().time();
+        REQUIRE_THROWS_AS(Run([&]() -> Task<> {
+                              TaskGroup group;
+                              group.Spawn(sleep_forever(cancelled));
+                              group.Spawn(fail_after(10ms));
+                              group.Spawn(sleep_forever(cancelled));
+                              co_await group.Wait();
+                          }()),
+                          std::runtime_error);
+        REQUIRE(cancelled == 2);
+        REQUIRE(GetEventLoop().time() - before < 1s);
+    }
+
+    GIVEN("explicit cancel wakes io wait") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+        bool read_cancelled = false;
+        Run([&]() -> Task<> {
+            Stream stream{fds[0]};
+            TaskGroup group;
+            // NOTE: lambda 协程的闭包对象必须活得比协程更久
+            auto read = [&]() -> Task<> {
+                try {
+                    co_await stream.Read(10);
+                } catch (CancelledError const&) {
+                    read_cancelled = true;
+                }
+            };
+            auto cancel = [&]() -> Task<> {
+                co_await Sleep(10ms);
+                group.Cancel();
+            };
+            group.Spawn(read());
+            group.Spawn(cancel());
+            co_await group.Wait();  // 显式取消: 正常返回
+            REQUIRE(group.IsCancelled());
+        }());
+        REQUIRE(read_cancelled);
+        ::close(fds[1]);
+    }
+
+    GIVEN("destroyed group releases its children's io waits") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+        Run([&]() -> Task<> {
+            Stream stream{fds[0]};
+            auto read = [&]() -> Task<> { co_await stream.Read(10); };
+            {
+                TaskGroup group;
+                group.Spawn(read());
+                co_await Sleep(1ms);  // 子任务挂起在读事件上
+            }  // 不等待直接销毁: 子任务的帧被销毁
+            REQUIRE(::write(fds[1], "hello", 5) == 5);
+            co_await Sleep(10ms);  // 数据到达时不能恢复已销毁的子任务
+            auto data = co_await stream.Read(10);
+            REQUIRE(std::string_view(data.data(), data.size()) == "hello");
+        }());
+        ::close(fds[1]);
+    }
+
+    GIVEN("nested group is cancelled with the outer one") {
+        int cancelled = 0;
+        Run([&]() -> Task<> {
+            TaskGroup outer;
+            auto nested = [&]() -> Task<> {
+                TaskGroup inner;
+                inner.Spawn(sleep_forever(cancelled));
+                inner.Spawn(sleep_forever(cancelled));
+                co_await inner.Wait();  // 外层被取消: 抛出 CancelledError
+            };
+            auto cancel = [&]() -> Task<> {
+                co_await Sleep(10ms);
+                outer.Cancel();
+            };
+            outer.Spawn(nested());
+            outer.Spawn(cancel());
+            co_await outer.Wait();
+        }());
+        REQUIRE(cancelled == 2);
+    }
+
+    GIVEN("scope waits for children on exit") {
+        std::vector<int> done;
+        Run([&]() -> Task<> {
+            co_await TaskGroup::Scope([&](TaskGroup& group) -> Task<> {
+                group.Spawn(sleep_then(10ms, done, 0));
+                co_return;
+            });
+            REQUIRE(done == std::vector<int>{0});
+        }());
+    }
+
+    GIVEN("scope cancels and drains children when the body throws") {
+        int cancelled = 0;
+        REQUIRE_THROWS_AS(Run(TaskGroup::Scope([&](TaskGroup& group) -> Task<> {
+                              group.Spawn(sleep_forever(cancelled));
+                              group.Spawn(sleep_forever(cancelled));
+                              co_await Sleep(1ms);
+                              throw std::runtime_error("body failed");
+                          })),
+                          std::runtime_error);
+        // 子任务在异常传出之前执行完各自的 catch
+        REQUIRE(cancelled == 2);
+    }
+
+    GIVEN("server connections are children of ServeForever") {
+        bool handler_cancelled = false;
+        auto handle = [&](Stream stream) -> Task<> {
+            auto data = co_await stream.Read(1);
+            if (data[0] == 'x') {
+                throw std::runtime_error("bad request");  // 只结束这个连接
+            }
+            try {
+                co_await stream.Read(1);
+            } catch (CancelledError const&) {
+                handler_cancelled = true;
+                throw;
+            }
+        };
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            auto serve = [&]() -> Task<> {
+                auto server = co_await StartServer(handle, "127.0.0.1", 8904);
+                co_await server.ServeForever();
+            };
+            group.Spawn(serve());
+            co_await Sleep(1ms);
+            auto bad = co_await OpenConnection("127.0.0.1", 8904);
+            Stream::Buffer request(1, 'x');
+            co_await bad.Write(request);
+            auto good = co_await OpenConnection("127.0.0.1", 8904);
+            request[0] = 'y';
+            co_await good.Write(request);
+            co_await Sleep(10ms);
+            REQUIRE(!handler_cancelled);
+            group.Cancel();  // 取消 ServeForever: 仍在运行的连接随之取消
+            co_await group.Wait();
+        }());
+        REQUIRE(handler_cancelled);
+    }
+
+    GIVEN("finished children are reclaimed") {
+        std::vector<int> done;
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            for (int i = 0; i < 1000; ++i) {
+                group.Spawn(sleep_then(0ms, done, i));
+                co_await Sleep(0ms);
+            }
+            co_await group.Wait();
+        }());
+        REQUIRE(done.size() == 1000);
+    }
+}
@@ -0,0 +1,109 @@
+#include <sys/socket.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+#include <map>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<int> traced_child(int x) {
+    co_await Sleep(1ms);
+    co_return x * 2;
+}
+
+Task<int> traced_parent() {
+    auto a = co_await traced_child(1);
+    auto b = co_await traced_child(2);
+    co_return a + b;
+}
+
+std::map<TraceEventType, size_t> CountEvents(TraceBuffer const& buffer) {
+    std::map<TraceEventType, size_t> counts;
+    buffer.ForEach([&](TraceEvent const& event) { ++counts[event.type]; });
+    return counts;
+}
+
+}  // namespace
+
+SCENARIO("test trace") {
+    auto& loop = GetEventLoop();
+
+#if ASYNCIO_ENABLE_TRACING
+    GIVEN("task lifecycle events") {
+        loop.EnableTracing();
+        REQUIRE(Run(traced_parent()) == 6);
+        loop.DisableTracing();
+        REQUIRE(Run(traced_parent()) == 6);  // 停止后不再记录
+
+        auto const& buffer = *loop.GetTraceBuffer();
+        auto counts = CountEvents(buffer);
+        // traced_parent, 2 个 traced_child, 2 个 Sleep
+        REQUIRE(counts[TraceEventType::CREATE] == 5);
+        REQUIRE(counts[TraceEventType::FINAL_SUSPEND] == 5);
+        REQUIRE(counts[TraceEventType::RESUME] == counts[TraceEventType::SUSPEND]);
+        REQUIRE(counts[TraceEventType::TIMER] == 2);
+        REQUIRE(counts[TraceEventType::SCHEDULE] > 0);
+        REQUIRE(buffer.Dropped() == 0);
+
+        int64_t last = 0;
+        buffer.ForEach([&](TraceEvent const& event) {
+            REQUIRE(event.time >= last);
+            last = event.time;
+        });
+
+        auto json = buffer.ToChromeJson();
+        REQUIRE(json.starts_with(R"({"displayTimeUnit":"ns","traceEvents":[)"));
+        REQUIRE(json.ends_with("]}\n"));
+        REQUIRE(json.find(R"("ph":"X")") != std::string::npos);
+        REQUIRE(json.find(R"("ph":"b")") != std::string::npos);
+        REQUIRE(json.find(R"("name":"timer")") != std::string::npos);
+#if ASYNCIO_ENABLE_FRAME_INFO
+        REQUIRE(json.find("traced_child") != std::string::npos);
+        REQUIRE(json.find("test_trace.cpp:") != std::string::npos);
+#else
+        REQUIRE(json.find("coroutine #") != std::string::npos);
+#endif
+    }
+
+    GIVEN("io wait") {
+        int fds[2];
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+        loop.EnableTracing();
+        Run([local_fd = fds[0], peer_fd = fds[1]]() -> Task<> {
+            Stream local{local_fd}, peer{peer_fd};
+            Stream::Buffer data(1, 'x');
+            co_await Gather(local.Read(1), peer.Write(data));
+        }());
+        loop.DisableTracing();
+        REQUIRE(CountEvents(*loop.GetTraceBuffer())[TraceEventType::IO_WAIT] >= 1);
+    }
+
+    GIVEN("ring buffer keeps the newest events") {
+        loop.EnableTracing(16);
+        Run([]() -> Task<> {
+            for (int i = 0; i < 20; ++i) {
+                co_await traced_child(i);
+            }
+        }());
+        loop.DisableTracing();
+        auto const& buffer = *loop.GetTraceBuffer();
+        REQUIRE(buffer.Size() == 16);
+        REQUIRE(buffer.Dropped() > 0);
+        auto json = buffer.ToChromeJson();  // 开始事件被覆盖的切片不输出
+        REQUIRE(json.ends_with("]}\n"));
+    }
+#endif
+
+    GIVEN("only the active buffer records") {
+        TraceBuffer buffer{4};
+        REQUIRE(buffer.ToChromeJson().ends_with("]}\n"));
+        buffer.Activate();
+        TraceBuffer::Emit(TraceEventType::SCHEDULE, 1);
+        buffer.Deactivate();
+        TraceBuffer::Emit(TraceEventType::SCHEDULE, 2);
+        REQUIRE(buffer.Size() == (ASYNCIO_ENABLE_TRACING ? 1 : 0));
+    }
+}
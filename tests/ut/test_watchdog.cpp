@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<> blocking_then_sleep() {
+    std::this_thread::sleep_for(50ms);  // 阻塞事件循环
+    co_await Sleep(1ms);
+}
+
+Task<> blocking_then_return() {
+    std::this_thread::sleep_for(50ms);
+    co_return;
+}
+
+Task<> blocking_child() {
+    co_await Sleep(1ms);
+    std::this_thread::sleep_for(200ms);
+}
+
+Task<> blocking_parent() { co_await blocking_child(); }
+
+}  // namespace
+
+SCENARIO("test slow callback check") {
+    auto& loop = GetEventLoop();
+    std::vector<SlowCallback> reports;
+    std::vector<std::string> names;
+    loop.EnableSlowCallbackCheck(20ms, [&](SlowCallback const& report) {
+        reports.push_back(report);
+        if (report.coroutine) {
+            names.push_back(report.coroutine->FrameName());
+        }
+    });
+
+#if ASYNCIO_ENABLE_LOOP_DEBUG
+    GIVEN("fast callbacks are not reported") {
+        Run([]() -> Task<> {
+            for (int i = 0; i < 10; ++i) {
+                co_await Sleep(1ms);
+            }
+        }());
+        REQUIRE(reports.empty());
+    }
+
+    GIVEN("blocking coroutine that is still alive") {
+        Run(blocking_then_sleep());
+        REQUIRE(reports.size() == 1);
+        REQUIRE(reports[0].duration >= 50ms);
+        REQUIRE(reports[0].coroutine != nullptr);  // 报告时协程挂起在 Sleep 中
+        REQUIRE(names.size() == 1);
+#if ASYNCIO_ENABLE_FRAME_INFO
+        REQUIRE(names[0].find("blocking_then_sleep") != std::string::npos);
+        REQUIRE(std::string_view{reports[0].location.function_name()}.find(
+                    "blocking_then_sleep") != std::string_view::npos);
+#endif
+    }
+
+    GIVEN("blocking coroutine that finished in the callback") {
+        Run(blocking_then_return());
+        REQUIRE(reports.size() == 1);
+        REQUIRE(reports[0].duration >= 50ms);
+        REQUIRE(reports[0].coroutine != nullptr);  // 停在 final_suspend, 由等待者销毁
+#if ASYNCIO_ENABLE_FRAME_INFO
+        REQUIRE(names[0].find("blocking_then_return") != std::string::npos);
+#endif
+    }
+
+    GIVEN("disabled") {
+        loop.DisableSlowCallbackCheck();
+        Run(blocking_then_return());
+        REQUIRE(reports.empty());
+    }
+#else
+    GIVEN("compiled out") {
+        Run(blocking_then_return());
+        REQUIRE(reports.empty());
+    }
+#endif
+
+    loop.DisableSlowCallbackCheck();
+}
+
+SCENARIO("test loop stall watchdog") {
+    auto& loop = GetEventLoop();
+    std::mutex mutex;
+    std::vector<LoopStall> reports;
+    loop.EnableWatchdog(40ms, [&](LoopStall const& report) {
+        std::lock_guard lock(mutex);  // 在看门狗线程中调用
+        reports.push_back(report);
+    });
+
+#if ASYNCIO_ENABLE_LOOP_DEBUG
+    GIVEN("idle loop is not a stall") {
+        Run([]() -> Task<> { co_await Sleep(200ms); }());
+        std::lock_guard lock(mutex);
+        REQUIRE(reports.empty());
+    }
+
+    GIVEN("stall reported once while stuck") {
+        Run(blocking_parent());
+        loop.DisableWatchdog();
+        std::lock_guard lock(mutex);
+        REQUIRE(reports.size() == 1);
+        REQUIRE(reports[0].duration >= 40ms);
+        REQUIRE(reports[0].duration < 200ms);
+#if ASYNCIO_ENABLE_FRAME_INFO
+        // 协程都已销毁, 报告中的源码位置仍然有效
+        auto& backtrace = reports[0].backtrace;
+        REQUIRE(backtrace.size() == 2);
+        REQUIRE(std::string_view{backtrace[0].function_name()}.find("blocking_child") !=
+                std::string_view::npos);
+        REQUIRE(std::string_view{backtrace[1].function_name()}.find("blocking_parent") !=
+                std::string_view::npos);
+        REQUIRE(reports[0].location.line() == backtrace[0].line());
+#else
+        REQUIRE(reports[0].backtrace.empty());
+#endif
+    }
+#else
+    GIVEN("compiled out") {
+        Run(blocking_parent());
+        loop.DisableWatchdog();
+        std::lock_guard lock(mutex);
+        REQUIRE(reports.empty());
+    }
+#endif
+
+    loop.DisableWatchdog();
+}
@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+#include <asyncio/asyncio.hpp>
+#include <vector>
+
+using namespace asyncio;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<> interleave(std::vector<int>& order, int id) {
+    for (int i = 0; i < 3; ++i) {
+        order.push_back(id);
+        co_await Yield();
+    }
+}
+
+// 通道中的数据全部已就绪: 每次 Recv 都不挂起
+Task<> drain(Channel<int>& channel, bool& done) {
+    while (true) {
+        auto value = co_await channel.Recv();
+        if (!value) {
+            break;
+        }
+    }
+    done = true;
+}
+
+Task<> ticker(bool const& done, size_t& ticks) {
+    while (!done) {
+        ++ticks;
+        co_await Yield();
+    }
+}
+
+Task<> increment(AsyncMutex& mutex, int& counter) {
+    for (int i = 0; i < 100; ++i) {
+        auto guard = co_await mutex.ScopedLock();
+        int value = counter;
+        co_await Yield();  // 持有锁时让出: 另一个协程在 ScopedLock 中挂起
+        counter = value + 1;
+    }
+}
+
+}  // namespace
+
+SCENARIO("test yield") {
+    GIVEN("yield interleaves ready coroutines") {
+        std::vector<int> order;
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            group.Spawn(interleave(order, 0));
+            group.Spawn(interleave(order, 1));
+            co_await group.Wait();
+        }());
+        REQUIRE(order == std::vector<int>{0, 1, 0, 1, 0, 1});
+    }
+
+    GIVEN("a cancelled coroutine stops at yield") {
+        bool cancelled = false;
+        auto spin = [&]() -> Task<> {
+            try {
+                while (true) {
+                    co_await Yield();
+                }
+            } catch (CancelledError const&) {
+                cancelled = true;
+            }
+        };
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            group.Spawn(spin());
+            co_await Sleep(1ms);
+            group.Cancel();
+            co_await group.Wait();
+        }());
+        REQUIRE(cancelled);
+    }
+}
+
+SCENARIO("test operation budget") {
+    auto& loop = GetEventLoop();
+    constexpr int kItems = 1000;
+
+    auto run = [&](uint32_t budget) {
+        loop.SetOperationBudget(budget);
+        Channel<int> channel;
+        for (int i = 0; i < kItems; ++i) {
+            REQUIRE(channel.TrySend(i));
+        }
+        channel.Close();
+        bool done = false;
+        size_t ticks = 0;
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            group.Spawn(drain(channel, done));
+            group.Spawn(ticker(done, ticks));
+            co_await group.Wait();
+        }());
+        loop.SetOperationBudget(ASYNCIO_OPERATION_BUDGET);
+        REQUIRE(done);
+        return ticks;
+    };
+
+    GIVEN("a hot channel consumer yields after the budget") {
+        auto ticks = run(16);
+        // 每 16 次不挂起的 Recv 之后让出一次
+        REQUIRE(ticks >= kItems / 32);
+        REQUIRE(loop.GetOperationBudget() == ASYNCIO_OPERATION_BUDGET);
+    }
+
+    GIVEN("budget 0 disables forced yields") {
+        auto ticks = run(0);
+        REQUIRE(ticks <= 2);
+        REQUIRE(loop.GetOperationBudget() == ASYNCIO_OPERATION_BUDGET);
+    }
+
+    GIVEN("a lock acquired before yielding stays owned") {
+        loop.SetOperationBudget(1);
+        AsyncMutex mutex;
+        int counter = 0;
+        Run([&]() -> Task<> {
+            TaskGroup group;
+            group.Spawn(increment(mutex, counter));
+            group.Spawn(increment(mutex, counter));
+            co_await group.Wait();
+        }());
+        loop.SetOperationBudget(ASYNCIO_OPERATION_BUDGET);
+        REQUIRE(counter == 200);
+        REQUIRE(!mutex.IsLocked());
+    }
+}
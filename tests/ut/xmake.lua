@@ -18,3 +18,73 @@ target("test_task", function()
     add_files("test_task.cpp")
 end)
 
+
+target("test_connection_pool", function()
+    set_kind("binary")
+    add_files("test_connection_pool.cpp")
+end)
+
+target("test_task_group", function()
+    set_kind("binary")
+    add_files("test_task_group.cpp")
+end)
+
+target("test_locks", function()
+    set_kind("binary")
+    add_files("test_locks.cpp")
+end)
+
+target("test_channel", function()
+    set_kind("binary")
+    add_files("test_channel.cpp")
+end)
+
+target("test_generator", function()
+    set_kind("binary")
+    add_files("test_generator.cpp")
+end)
+
+target("test_frame_size", function()
+    set_kind("binary")
+    add_files("test_frame_size.cpp")
+end)
+
+target("test_context", function()
+    set_kind("binary")
+    add_files("test_context.cpp")
+end)
+
+target("test_metrics", function()
+    set_kind("binary")
+    add_files("test_metrics.cpp")
+end)
+
+target("test_trace", function()
+    set_kind("binary")
+    add_files("test_trace.cpp")
+end)
+
+target("test_watchdog", function()
+    set_kind("binary")
+    add_files("test_watchdog.cpp")
+end)
+
+target("test_task_accounting", function()
+    set_kind("binary")
+    add_files("test_task_accounting.cpp")
+end)
+
+target("test_busy_poll", function()
+    set_kind("binary")
+    add_files("test_busy_poll.cpp")
+end)
+
+target("test_priority", function()
+    set_kind("binary")
+    add_files("test_priority.cpp")
+end)
+
+target("test_yield", function()
+    set_kind("binary")
+    add_files("test_yield.cpp")
+end)
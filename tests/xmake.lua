@@ -2,10 +2,11 @@ add_packages("catch2")
 
 add_deps("asyncio")
 
--- pt: performance tests
+-- bench: benchmarks
 -- st: sample tests
 -- ut: unit tests
 
+includes("bench")
 includes("st")
 includes("ut")
 includes("misc")
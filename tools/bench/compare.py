@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""
+对比两份 run.py 的输出 (或单个基准的 --json 输出), 标出变差超过阈值的指标
+- 按每项指标的方向判断变好/变差 (吞吐量越大越好, 耗时越小越好)
+- 存在回退时退出码为 1, 可用于 CI
+- 用法: python3 tools/bench/compare.py baseline.json current.json [--threshold 10]
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    # 单个基准的 --json 输出 (suite 在顶层) 也可以直接对比
+    suite = report.get("suite")
+    return report.get("build", ""), {(r.get("suite", suite), r["name"]): r for r in report["results"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0, help="判定为回退的变差百分比")
+    args = parser.parse_args()
+
+    baseline_build, baseline = load(args.baseline)
+    current_build, current = load(args.current)
+    if baseline_build != current_build:
+        print(f"warning: comparing {baseline_build} baseline with {current_build} build", file=sys.stderr)
+
+    regressions = 0
+    for key in sorted(baseline.keys() | current.keys()):
+        suite, name = key
+        label = f"{suite}: {name}"
+        if key not in current:
+            print(f"  {label:<64} (removed)")
+            continue
+        if key not in baseline:
+            print(f"  {label:<64} (new) {current[key]['value']:.2f} {current[key]['unit']}")
+            continue
+        old, new = baseline[key]["value"], current[key]["value"]
+        unit = current[key]["unit"]
+        if old == 0:
+            change = 0.0
+        else:
+            change = (new - old) / old * 100
+        # 正数表示变好
+        gain = change if current[key]["better"] == "higher" else -change
+        mark = " "
+        if gain < -args.threshold:
+            mark = "!"
+            regressions += 1
+        elif gain > args.threshold:
+            mark = "+"
+        print(f"{mark} {label:<64} {old:>10.2f} -> {new:>10.2f} {unit:<16} {change:+7.1f}%")
+
+    if regressions:
+        print(f"\n{regressions} regression(s) over {args.threshold:.0f}%")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""
+运行 tests/bench 下的基准测试, 汇总为一个 JSON 文件 (供 compare.py 与基线对比)
+- 每个基准运行 --repeat 次, 每项指标取最好的一次 (吞吐量取最大, 耗时取最小), 降低噪声
+- 用法: xmake f -m release && xmake build -g bench   (或逐个 xmake build bench_xxx)
+        python3 tools/bench/run.py -o current.json [bench_task bench_timer ...]
+"""
+
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def find_binaries(build_dir, names):
+    found = {}
+    for path in glob.glob(os.path.join(build_dir, "**", "bench_*"), recursive=True):
+        name = os.path.basename(path)
+        if os.path.isfile(path) and os.access(path, os.X_OK) and (not names or name in names):
+            found.setdefault(name, path)
+    missing = set(names) - set(found)
+    if missing:
+        sys.exit(f"not found in {build_dir}: {', '.join(sorted(missing))}")
+    return dict(sorted(found.items()))
+
+
+def run_once(path):
+    with tempfile.NamedTemporaryFile(suffix=".json") as out:
+        subprocess.run([path, "--json", out.name], check=True, stdout=subprocess.DEVNULL)
+        with open(out.name) as f:
+            return json.load(f)
+
+
+def better(a, b, direction):
+    return max(a, b) if direction == "higher" else min(a, b)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("benches", nargs="*", help="基准名 (默认全部)")
+    parser.add_argument("--build-dir", default="build", help="可执行文件所在目录 (递归查找 bench_*)")
+    parser.add_argument("--repeat", type=int, default=3, help="每个基准的运行次数")
+    parser.add_argument("-o", "--output", required=True, help="输出的 JSON 文件")
+    args = parser.parse_args()
+
+    results = {}  # (suite, name) -> result
+    builds = set()
+    for name, path in find_binaries(args.build_dir, args.benches).items():
+        for i in range(args.repeat):
+            print(f"[{i + 1}/{args.repeat}] {name}", file=sys.stderr)
+            report = run_once(path)
+            builds.add(report["build"])
+            for result in report["results"]:
+                key = (report["suite"], result["name"])
+                if key in results:
+                    old = results[key]
+                    old["value"] = better(old["value"], result["value"], result["better"])
+                else:
+                    results[key] = dict(result, suite=report["suite"])
+    if "debug" in builds:
+        print("warning: debug build, numbers are not comparable to a release baseline", file=sys.stderr)
+
+    with open(args.output, "w") as f:
+        json.dump({"build": ",".join(sorted(builds)), "results": list(results.values())}, f, indent=1)
+    print(f"{len(results)} results written to {args.output}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()